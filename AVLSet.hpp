@@ -16,23 +16,45 @@
 // in your data structure.  Instead, you'll need to implement your AVL tree
 // using your own dynamically-allocated nodes, with pointers connecting them,
 // and with your own balancing algorithms used.
+//
+// The nodes are created and destroyed by the NodeAllocator named in the
+// AVLSet's type (see NodePool.hpp), which defaults to a NodePool.
 
 #ifndef AVLSET_HPP
 #define AVLSET_HPP
 
+#include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
 #include "Set.hpp"
+#include "StringLookup.hpp"
 using namespace std;
 
 
-template <typename ElementType>
-class AVLSet : public Set<ElementType>
+template <typename ElementType, template <typename> typename NodeAllocator = NodePool>
+class AVLSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, AVLSet<ElementType, NodeAllocator>>,
+    public OrderedLookup<ElementType, AVLSet<ElementType, NodeAllocator>>
 {
 public:
     // A VisitFunction is a function that takes a reference to a const
     // ElementType and returns no value.
     using VisitFunction = std::function<void(const ElementType&)>;
 
+    class InorderIterator;
+    class PreorderIterator;
+
+    // Iterating through an AVLSet (e.g., with a range-based for loop or a
+    // standard algorithm) visits its elements in ascending order.
+    using iterator = InorderIterator;
+    using const_iterator = InorderIterator;
+
 public:
     // Initializes an AVLSet to be empty, with or without balancing.
     explicit AVLSet(bool shouldBalance = true);
@@ -65,21 +87,80 @@ public:
     virtual void add(const ElementType& element) override;
 
 
+    // addSorted() adds every element in the range [first, last) to the set.
+    // When the set is empty and the range is sorted (as a dictionary file
+    // usually is), the tree is built directly from it, perfectly balanced,
+    // in O(n) time.  Otherwise, the range is copied and sorted, and then
+    // merged with the elements already in the set before the tree is
+    // rebuilt, which takes O(n log n + m) time when there are m elements in
+    // the set already.  Either way, duplicates have no effect.
+    template <typename InputIterator>
+    void addSorted(InputIterator first, InputIterator last);
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function always runs in O(log n) time when
     // there are n elements in the AVL tree.
     virtual bool contains(const ElementType& element) const override;
 
 
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements using == and <, such as a
+    // std::string_view when the elements are std::strings.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
+    // containsSorted() writes to "out", for each key in the range
+    // [first, last), whether the set contains it, and returns the output
+    // iterator just past the last result written.  The keys must be in
+    // ascending order (duplicates are fine), so that each search can begin
+    // where the previous one left off instead of at the root: it only
+    // climbs back up as far as the smallest subtree that can contain the
+    // next key.  Looking up m sorted keys this way takes O(m log(n / m))
+    // time, rather than the O(m log n) time it takes to call contains()
+    // for each one.  (The keys can be anything containsKey() accepts.)
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator containsSorted(InputIterator first, InputIterator last, OutputIterator out) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept override;
 
 
     // height() returns the height of the AVL tree.  Note that, by definition,
-    // the height of an empty tree is -1.
+    // the height of an empty tree is -1.  This function runs in O(1) time.
     int height() const;
 
 
+    // prefixScan() calls the given "visit" function for each element in
+    // the set that begins with the given prefix, in ascending order,
+    // stopping after it has visited "limit" of them, and returns the number
+    // of elements visited.  The first such element is found in O(log n)
+    // time, and the scan stops at the first element after it that doesn't
+    // begin with the prefix, so it never visits the rest of the tree.  (It
+    // can only be used when the elements can be viewed as a
+    // std::string_view, e.g., when they're std::strings.)
+    template <typename Visitor>
+    unsigned int prefixScan(std::string_view prefix, unsigned int limit, Visitor&& visit) const;
+
+
+    // begin() and end() return iterators that visit the elements in the
+    // order determined by an inorder traversal of the AVL tree, which is
+    // ascending order.  The iterators are invalidated when an element is
+    // added to the set.
+    InorderIterator begin() const;
+    InorderIterator end() const;
+
+
+    // preorderBegin() and preorderEnd() return iterators that visit the
+    // elements in the order determined by a preorder traversal of the AVL
+    // tree.  Like begin() and end(), they're invalidated when an element is
+    // added to the set.
+    PreorderIterator preorderBegin() const;
+    PreorderIterator preorderEnd() const;
+
+
     // preorder() calls the given "visit" function for each of the elements
     // in the set, in the order determined by a preorder traversal of the AVL
     // tree.
@@ -104,49 +185,205 @@ private:
         ElementType value;
         Node* left = nullptr;
         Node* right = nullptr;
+
+        // The height of the subtree rooted at this node, kept up to date
+        // as nodes are added and rotated, so that neither balancing nor
+        // height() ever has to walk a subtree to measure it.
+        int height = 0;
     };
     Node* root;
     Node* current;
+    NodeAllocator<Node> node_allocator;
     
     bool balance = true;
     int total_size = 0;
-    int the_height(Node*& temp) const;
+    int the_height(const Node* temp) const;
+    void update_height(Node* current);
     void delete_tree(Node* current);
     void copy_tree(Node*& current, const Node* src);
     void insert_node(Node*& current, const ElementType& element);
     void insert_node_not_balance(Node*& current, const ElementType& element);
     void rotate_left(Node*& current);
     void rotate_right(Node*& current);
-    void pre_ord(Node* current, VisitFunction visit) const;
-    void in_ord(Node* current, VisitFunction visit) const;
     void post_ord(Node* current, VisitFunction visit) const;
-    bool if_contain(const ElementType& element, Node* current) const;
+    template <typename Key>
+    bool if_contain(const Key& element, Node* current) const;
+    template <typename RandomAccessIterator>
+    Node* build_balanced(RandomAccessIterator first, std::size_t count);
+    InorderIterator first_not_less(std::string_view key) const;
+};
+
+
+
+// An InorderIterator keeps a stack of the nodes whose elements it has yet to
+// visit and whose left subtrees it has already descended into; the top of
+// the stack is the node it currently refers to.  Moving forward pops that
+// node and pushes the path to the smallest element of its right subtree, so
+// the stack never holds more than one node per level of the tree, and each
+// node is pushed and popped once over a whole traversal.
+template <typename ElementType, template <typename> typename NodeAllocator>
+class AVLSet<ElementType, NodeAllocator>::InorderIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    // Initializes an iterator equal to end().
+    InorderIterator() = default;
+
+    reference operator*() const
+    {
+        return pending.back() -> value;
+    }
+
+    pointer operator->() const
+    {
+        return &pending.back() -> value;
+    }
+
+    InorderIterator& operator++()
+    {
+        const Node* visited = pending.back();
+        pending.pop_back();
+        push_leftmost(visited -> right);
+        return *this;
+    }
+
+    InorderIterator operator++(int)
+    {
+        InorderIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const InorderIterator& other) const
+    {
+        return pending.empty()
+            ? other.pending.empty()
+            : !other.pending.empty() && pending.back() == other.pending.back();
+    }
+
+    bool operator!=(const InorderIterator& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    friend class AVLSet;
+
+    std::vector<const Node*> pending;
+
+    void push_leftmost(const Node* n)
+    {
+        for(; n != nullptr; n = n -> left)
+        {
+            pending.push_back(n);
+        }
+    }
+};
+
+
+
+// A PreorderIterator keeps a stack of the subtrees it has yet to visit; the
+// node on top of the stack is the one it currently refers to.  Moving
+// forward replaces that node with its right and left children (the left one
+// on top, so it's visited first).  The stack holds at most one node per
+// level of the tree, plus one.
+template <typename ElementType, template <typename> typename NodeAllocator>
+class AVLSet<ElementType, NodeAllocator>::PreorderIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ElementType;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const ElementType*;
+    using reference = const ElementType&;
+
+    // Initializes an iterator equal to preorderEnd().
+    PreorderIterator() = default;
+
+    reference operator*() const
+    {
+        return pending.back() -> value;
+    }
+
+    pointer operator->() const
+    {
+        return &pending.back() -> value;
+    }
+
+    PreorderIterator& operator++()
+    {
+        const Node* visited = pending.back();
+        pending.pop_back();
+
+        if(visited -> right != nullptr)
+        {
+            pending.push_back(visited -> right);
+        }
+        if(visited -> left != nullptr)
+        {
+            pending.push_back(visited -> left);
+        }
+        return *this;
+    }
+
+    PreorderIterator operator++(int)
+    {
+        PreorderIterator old = *this;
+        ++*this;
+        return old;
+    }
+
+    bool operator==(const PreorderIterator& other) const
+    {
+        return pending.empty()
+            ? other.pending.empty()
+            : !other.pending.empty() && pending.back() == other.pending.back();
+    }
+
+    bool operator!=(const PreorderIterator& other) const
+    {
+        return !(*this == other);
+    }
+
+private:
+    friend class AVLSet;
+
+    std::vector<const Node*> pending;
 };
 
 ///-----------------------------Helper Functions------------------------------------------
-template <typename ElementType>
-int AVLSet<ElementType>::the_height(Node*& temp) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+int AVLSet<ElementType, NodeAllocator>::the_height(const Node* temp) const
 {
-    int left;
-    int right;
     if(temp == nullptr)
     {
         return -1;
     }
-    left = the_height(temp -> left);
-    right = the_height(temp -> right);
+    return temp -> height;
+}
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::update_height(Node* current)
+{
+    int left = the_height(current -> left);
+    int right = the_height(current -> right);
     if(left > right)
     {
-        return left+1;
+        current -> height = left+1;
     }
     else
     {
-        return right+1;
+        current -> height = right+1;
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::delete_tree(Node* current)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::delete_tree(Node* current)
 {
     if(current == nullptr)
     {
@@ -154,11 +391,11 @@ void AVLSet<ElementType>::delete_tree(Node* current)
     }
     delete_tree(current -> left);
     delete_tree(current -> right);
-    delete current;
+    node_allocator.destroy(current);
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::copy_tree(Node*& current, const Node* src)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::copy_tree(Node*& current, const Node* src)
 {
     if(src == nullptr)
     {
@@ -166,22 +403,19 @@ void AVLSet<ElementType>::copy_tree(Node*& current, const Node* src)
     }
     else
     {
-        current = new Node{src -> value};
-        if(current -> left == nullptr && current -> right == nullptr)
-        {
-            return;
-        }
+        current = node_allocator.create(src -> value);
+        current -> height = src -> height;
         copy_tree(current -> left,src -> left);
         copy_tree(current -> right,src -> right);
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::insert_node(Node*& current, const ElementType& element)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::insert_node(Node*& current, const ElementType& element)
 {
     if(current == nullptr)
     {
-        current = new Node{element};
+        current = node_allocator.create(element);
     }
     else if(element > current -> value)
     {
@@ -198,6 +432,7 @@ void AVLSet<ElementType>::insert_node(Node*& current, const ElementType& element
                 rotate_right(current);
             }
         }
+        update_height(current);
     }
     else if(element < current -> value)
     {
@@ -214,70 +449,55 @@ void AVLSet<ElementType>::insert_node(Node*& current, const ElementType& element
                 rotate_left(current);
             }
         }
+        update_height(current);
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::insert_node_not_balance(Node*& current, const ElementType& element)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::insert_node_not_balance(Node*& current, const ElementType& element)
 {
     if(current == nullptr)
     {
-        current = new Node{element};
+        current = node_allocator.create(element);
     }
     else if(element > current-> value)
     {
         insert_node_not_balance(current->right,element);
+        update_height(current);
     }
     else if(element<current->value)
     {
         insert_node_not_balance(current->left,element);
+        update_height(current);
     }
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::rotate_left(Node*& current)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::rotate_left(Node*& current)
 {
     Node* result;
     result = current -> left;
     current -> left = result -> right;
     result -> right = current;
+    update_height(current);
+    update_height(result);
     current = result;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::rotate_right(Node*& current)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::rotate_right(Node*& current)
 {
     Node* result;
     result = current -> right;
     current -> right = result -> left;
     result -> left = current;
+    update_height(current);
+    update_height(result);
     current = result;
 }
 
-template <typename ElementType>
-void AVLSet<ElementType>::pre_ord(Node* current, VisitFunction visit) const
-{
-    if(current != nullptr)
-    {
-        visit(current -> value);
-        pre_ord(current->left, visit);
-        pre_ord(current->right, visit);
-    }
-}
-
-template <typename ElementType>
-void AVLSet<ElementType>::in_ord(Node* current, VisitFunction visit) const
-{
-    if(current!=nullptr)
-    {
-        in_ord(current->left, visit);
-        visit(current->value);
-        in_ord(current->right, visit);
-    }
-}        
-
-template <typename ElementType>
-void AVLSet<ElementType>::post_ord(Node* current, VisitFunction visit) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::post_ord(Node* current, VisitFunction visit) const
 {
     if(current!=nullptr)
     {
@@ -287,8 +507,9 @@ void AVLSet<ElementType>::post_ord(Node* current, VisitFunction visit) const
     }
 }
 
-template <typename ElementType>
-bool AVLSet<ElementType>::if_contain(const ElementType& element, Node* current) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+bool AVLSet<ElementType, NodeAllocator>::if_contain(const Key& element, Node* current) const
 {
     while(current != nullptr)
     {
@@ -307,68 +528,143 @@ bool AVLSet<ElementType>::if_contain(const ElementType& element, Node* current)
     }
     return false;
 }
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename RandomAccessIterator>
+typename AVLSet<ElementType, NodeAllocator>::Node* AVLSet<ElementType, NodeAllocator>::build_balanced(
+    RandomAccessIterator first, std::size_t count)
+{
+    if(count == 0)
+    {
+        return nullptr;
+    }
+    // If creating a node throws, the part of the tree that's already been
+    // built is destroyed, so a failed build leaks nothing.
+    std::size_t middle = count / 2;
+    Node* left = build_balanced(first, middle);
+    Node* current = nullptr;
+    try
+    {
+        current = node_allocator.create(first[middle], left);
+    }
+    catch(...)
+    {
+        delete_tree(left);
+        throw;
+    }
+    try
+    {
+        current -> right = build_balanced(first + middle + 1, count - middle - 1);
+    }
+    catch(...)
+    {
+        delete_tree(current);
+        throw;
+    }
+    update_height(current);
+    return current;
+}
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::InorderIterator AVLSet<ElementType, NodeAllocator>::first_not_less(
+    std::string_view key) const
+{
+    // The nodes on the path to the first element not less than the key
+    // whose left subtrees the path descends into are exactly the ones an
+    // inorder traversal would have on its stack when it reached it.
+    InorderIterator i;
+    i.pending.reserve(height() + 1);
+
+    for(const Node* n = root; n != nullptr;)
+    {
+        if(std::string_view{n -> value} < key)
+        {
+            n = n -> right;
+        }
+        else
+        {
+            i.pending.push_back(n);
+            n = n -> left;
+        }
+    }
+    return i;
+}
 ///--------------------------------------------------------------------------------------
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(bool shouldBalance)
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(bool shouldBalance)
 {
     root = nullptr;
     balance = shouldBalance;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::~AVLSet() noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::~AVLSet() noexcept
 {
-    delete_tree(root);
+    // A pool releases every node at once when it's destroyed, so the tree
+    // only needs to be walked if the nodes have destructors to run.
+    if constexpr (!NodeAllocator<Node>::releasesInBulk || !std::is_trivially_destructible_v<Node>)
+    {
+        delete_tree(root);
+    }
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(const AVLSet& s)
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(const AVLSet& s)
+    :balance{s.balance}, total_size{s.total_size}
 {
     copy_tree(root, s.root);
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>::AVLSet(AVLSet&& s) noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>::AVLSet(AVLSet&& s) noexcept
     :root{nullptr}
 {
     swap(root,s.root);
+    swap(balance,s.balance);
+    swap(total_size,s.total_size);
+    node_allocator.swap(s.node_allocator);
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(const AVLSet& s)
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>& AVLSet<ElementType, NodeAllocator>::operator=(const AVLSet& s)
 {
     if(this != &s)
     {
         delete_tree(this -> root);
         root = nullptr;
         copy_tree(root,s.root);
+        balance = s.balance;
+        total_size = s.total_size;
     }
     return *this;
 }
 
 
-template <typename ElementType>
-AVLSet<ElementType>& AVLSet<ElementType>::operator=(AVLSet&& s) noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+AVLSet<ElementType, NodeAllocator>& AVLSet<ElementType, NodeAllocator>::operator=(AVLSet&& s) noexcept
 {
     swap(root,s.root);
+    swap(balance,s.balance);
+    swap(total_size,s.total_size);
+    node_allocator.swap(s.node_allocator);
     return *this;
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::add(const ElementType& element)
 {
     try
     {
@@ -396,59 +692,209 @@ void AVLSet<ElementType>::add(const ElementType& element)
 }
 
 
-template <typename ElementType>
-bool AVLSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename InputIterator>
+void AVLSet<ElementType, NodeAllocator>::addSorted(InputIterator first, InputIterator last)
+{
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+    {
+        auto outOfOrder = [](const auto& a, const auto& b) { return !(a < b); };
+
+        if(root == nullptr && std::adjacent_find(first, last, outOfOrder) == last)
+        {
+            root = build_balanced(first, static_cast<std::size_t>(last - first));
+            total_size = static_cast<int>(last - first);
+            return;
+        }
+    }
+
+    std::vector<ElementType> added(first, last);
+    std::sort(added.begin(), added.end());
+    added.erase(std::unique(added.begin(), added.end()), added.end());
+
+    // The elements already in the set are copied, in order, and merged with
+    // the new ones; equal elements are kept once.  The existing tree is
+    // left alone until the new one has been built, so that the set is
+    // unchanged if anything along the way throws.
+    std::vector<ElementType> merged;
+    merged.reserve(total_size + added.size());
+    std::set_union(
+        begin(), end(),
+        std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()),
+        std::back_inserter(merged));
+
+    Node* rebuilt = build_balanced(std::make_move_iterator(merged.begin()), merged.size());
+    delete_tree(root);
+    root = rebuilt;
+    total_size = static_cast<int>(merged.size());
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool AVLSet<ElementType, NodeAllocator>::contains(const ElementType& element) const
 {    
     return if_contain(element, root);
 }
 
 
-template <typename ElementType>
-unsigned int AVLSet<ElementType>::size() const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+bool AVLSet<ElementType, NodeAllocator>::containsKey(const Key& key) const
+{
+    return if_contain(key, root);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename InputIterator, typename OutputIterator>
+OutputIterator AVLSet<ElementType, NodeAllocator>::containsSorted(
+    InputIterator first, InputIterator last, OutputIterator out) const
+{
+    // "bounds" holds the nodes on the path to the previous key at which
+    // the search went left (or found the key), so each is greater than or
+    // equal to the previous key, and the ones nearer the top of the stack
+    // are smaller.  The next key is greater than or equal to the previous
+    // one, so it's either equal to the top of the stack or, if it's greater
+    // than some of the nodes there, it's in the right subtree of the last
+    // (i.e., highest) of them to be popped.  If none are popped, it falls
+    // in the same gap between elements that the previous key did, so it
+    // isn't in the set.
+    std::vector<const Node*> bounds;
+    bounds.reserve(height() + 1);
+    const Node* subtree = root;
+
+    for(; first != last; ++first)
+    {
+        const auto& key = *first;
+
+        while(!bounds.empty() && bounds.back() -> value < key)
+        {
+            subtree = bounds.back() -> right;
+            bounds.pop_back();
+        }
+
+        bool found = !bounds.empty() && bounds.back() -> value == key;
+
+        for(const Node* n = subtree; !found && n != nullptr;)
+        {
+            if(n -> value < key)
+            {
+                n = n -> right;
+            }
+            else
+            {
+                bounds.push_back(n);
+                found = n -> value == key;
+                n = n -> left;
+            }
+        }
+
+        subtree = nullptr;
+        *out++ = found;
+    }
+    return out;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+unsigned int AVLSet<ElementType, NodeAllocator>::size() const noexcept
 {
     return total_size;
 }
 
 
-template <typename ElementType>
-int AVLSet<ElementType>::height() const
+template <typename ElementType, template <typename> typename NodeAllocator>
+int AVLSet<ElementType, NodeAllocator>::height() const
 {
-    Node* result = root;
-    return the_height(result);
+    return the_height(root);
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::preorder(VisitFunction visit) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Visitor>
+unsigned int AVLSet<ElementType, NodeAllocator>::prefixScan(
+    std::string_view prefix, unsigned int limit, Visitor&& visit) const
 {
-    try
+    // Elements beginning with the prefix are contiguous in ascending order,
+    // so the scan starts at the first one not less than the prefix and
+    // stops at the first one that doesn't begin with it.
+    unsigned int visited = 0;
+    for(InorderIterator i = first_not_less(prefix); visited < limit && i != end(); ++i)
     {
-    pre_ord(root, visit);
+        if(std::string_view{*i}.substr(0, prefix.size()) != prefix)
+        {
+            break;
+        }
+
+        visit(*i);
+        visited++;
     }
-    catch(...)
+    return visited;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::InorderIterator AVLSet<ElementType, NodeAllocator>::begin() const
+{
+    InorderIterator i;
+    i.pending.reserve(height() + 1);
+    i.push_leftmost(root);
+    return i;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::InorderIterator AVLSet<ElementType, NodeAllocator>::end() const
+{
+    return InorderIterator{};
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::PreorderIterator AVLSet<ElementType, NodeAllocator>::preorderBegin() const
+{
+    PreorderIterator i;
+    if(root != nullptr)
     {
-        throw;
+        i.pending.reserve(height() + 2);
+        i.pending.push_back(root);
     }
+    return i;
 }
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::inorder(VisitFunction visit) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename AVLSet<ElementType, NodeAllocator>::PreorderIterator AVLSet<ElementType, NodeAllocator>::preorderEnd() const
 {
-    try
-    {    
-        in_ord(root, visit);
+    return PreorderIterator{};
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::preorder(VisitFunction visit) const
+{
+    for(PreorderIterator i = preorderBegin(); i != preorderEnd(); ++i)
+    {
+        visit(*i);
     }
-    catch(...)
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::inorder(VisitFunction visit) const
+{
+    for(const ElementType& element : *this)
     {
-        throw;
+        visit(element);
     }
 }
 
 
 
-template <typename ElementType>
-void AVLSet<ElementType>::postorder(VisitFunction visit) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+void AVLSet<ElementType, NodeAllocator>::postorder(VisitFunction visit) const
 {
     try
     {
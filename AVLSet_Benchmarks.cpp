@@ -0,0 +1,131 @@
+// AVLSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks for AVLSet.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmark.hpp"
+
+
+namespace
+{
+    // sortedDictionary() returns the given number of distinct words in
+    // alphabetical order, the way a dictionary file is usually stored.
+    std::vector<std::string> sortedDictionary(unsigned int size, unsigned int seed)
+    {
+        std::vector<std::string> words = bench::makeWords(size, seed);
+        std::sort(words.begin(), words.end());
+        return words;
+    }
+}
+
+
+BENCHMARK(AVLSet, sortedDictionaryBuild)
+{
+    // If adding is O(log n), the time per add divided by log n stays flat
+    // as the dictionary doubles in size.
+    for (unsigned int size : {31250u, 62500u, 125000u, 250000u})
+    {
+        std::vector<std::string> words = sortedDictionary(size, 11);
+
+        bench::Stopwatch watch;
+        AVLSet<std::string> set;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        double ns = bench::nanosPerOperation(watch, size);
+
+        std::printf("  %7u words  %8.1f ms  %7.1f ns/add  %5.1f ns/(add * log2 n)  height %d\n",
+            size, watch.elapsedMilliseconds(), ns, ns / std::log2(size), set.height());
+    }
+}
+
+
+BENCHMARK(AVLSet, bulkBuild)
+{
+    for (unsigned int size : {250000u, 1000000u})
+    {
+        std::vector<std::string> words = sortedDictionary(size, 12);
+
+        bench::Stopwatch watch;
+        AVLSet<std::string> added;
+
+        for (const std::string& word : words)
+        {
+            added.add(word);
+        }
+
+        double addMs = watch.elapsedMilliseconds();
+        watch.restart();
+
+        AVLSet<std::string> sorted;
+        sorted.addSorted(words.begin(), words.end());
+
+        double sortedMs = watch.elapsedMilliseconds();
+
+        std::vector<std::string> shuffled = bench::makeWords(size, 12);
+        watch.restart();
+
+        AVLSet<std::string> unsorted;
+        unsorted.addSorted(shuffled.begin(), shuffled.end());
+
+        double unsortedMs = watch.elapsedMilliseconds();
+
+        std::printf("  %7u words  add() %7.1f ms  addSorted() sorted %6.1f ms  unsorted %6.1f ms  heights %d/%d/%d\n",
+            size, addMs, sortedMs, unsortedMs, added.height(), sorted.height(), unsorted.height());
+    }
+}
+
+
+BENCHMARK(AVLSet, dictionaryDump)
+{
+    for (unsigned int size : {250000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 16);
+        AVLSet<std::string> set;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        std::size_t totalLength = 0;
+        bench::Stopwatch watch;
+        set.inorder([&](const std::string& word) { totalLength += word.size(); });
+        double callbackNs = bench::nanosPerOperation(watch, size);
+
+        watch.restart();
+        for (const std::string& word : set)
+        {
+            totalLength += word.size();
+        }
+        double iteratorNs = bench::nanosPerOperation(watch, size);
+
+        watch.restart();
+        set.preorder([&](const std::string& word) { totalLength += word.size(); });
+        double preorderCallbackNs = bench::nanosPerOperation(watch, size);
+
+        watch.restart();
+        for (auto i = set.preorderBegin(); i != set.preorderEnd(); ++i)
+        {
+            totalLength += i->size();
+        }
+        double preorderIteratorNs = bench::nanosPerOperation(watch, size);
+
+        bench::doNotOptimize(totalLength);
+
+        std::printf("  %7u words  inorder: callback %5.1f ns/word  iterator %5.1f ns/word"
+            "  preorder: callback %5.1f ns/word  iterator %5.1f ns/word\n",
+            size, callbackNs, iteratorNs, preorderCallbackNs, preorderIteratorNs);
+    }
+}
@@ -0,0 +1,406 @@
+// AVLSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for AVLSet beyond the provided sanity checks.
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+
+
+
+namespace
+{
+    // An element whose copies start throwing once copiesLeft reaches zero,
+    // so that an operation can be made to fail part-way through.
+    struct Fragile
+    {
+        static int copiesLeft;
+
+        int value = 0;
+
+        Fragile() = default;
+
+        Fragile(int value)
+            : value{value}
+        {
+        }
+
+        Fragile(const Fragile& other)
+            : value{other.value}
+        {
+            if (copiesLeft == 0)
+            {
+                throw std::runtime_error{"copy failed"};
+            }
+
+            --copiesLeft;
+        }
+
+        Fragile& operator=(const Fragile& other) = default;
+
+        bool operator<(const Fragile& other) const { return value < other.value; }
+        bool operator==(const Fragile& other) const { return value == other.value; }
+        bool operator>(const Fragile& other) const { return other < *this; }
+    };
+
+    int Fragile::copiesLeft = -1;
+}
+
+
+TEST(AVLSet_Tests, canLookUpStringsByView)
+{
+    AVLSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+    s.add("BOO");
+
+    std::string text = "BOOHELLOTHERE";
+    std::string_view view = text;
+    const StringViewLookup& lookup = s;
+
+    EXPECT_TRUE(lookup.containsView(view.substr(0, 3)));
+    EXPECT_TRUE(lookup.containsView(view.substr(3, 5)));
+    EXPECT_TRUE(lookup.containsView(view.substr(8)));
+    EXPECT_FALSE(lookup.containsView(view.substr(0, 4)));
+    EXPECT_FALSE(lookup.containsView(view.substr(0, 0)));
+}
+
+
+TEST(AVLSet_Tests, heightStaysLogarithmicWhenAddingInOrder)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 1023; ++i)
+    {
+        s.add(i);
+    }
+
+    // 1023 elements in ascending order make a perfect tree.
+    EXPECT_EQ(9, s.height());
+
+    for (int i = 1023; i < 100000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(100000, s.size());
+    EXPECT_LE(s.height(), 24);
+}
+
+
+TEST(AVLSet_Tests, heightIsKeptWithoutBalancing)
+{
+    AVLSet<int> s{false};
+    EXPECT_EQ(-1, s.height());
+
+    for (int i = 0; i < 50; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(49, s.height());
+
+    s.add(-1);
+    s.add(-2);
+    EXPECT_EQ(49, s.height());
+}
+
+
+TEST(AVLSet_Tests, copiesKeepEveryElementAndTheHeight)
+{
+    AVLSet<int> s;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i * 7 % 100);
+    }
+
+    AVLSet<int> copy{s};
+    AVLSet<int> assigned;
+    assigned = s;
+
+    for (const AVLSet<int>* t : {&copy, &assigned})
+    {
+        EXPECT_EQ(s.size(), t->size());
+        EXPECT_EQ(s.height(), t->height());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            EXPECT_TRUE(t->contains(i));
+        }
+    }
+}
+
+
+TEST(AVLSet_Tests, addSortedBuildsAPerfectlyBalancedTree)
+{
+    std::vector<int> sorted;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        sorted.push_back(i * 2);
+    }
+
+    AVLSet<int> s;
+    s.addSorted(sorted.begin(), sorted.end());
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_EQ(9, s.height());
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, s.contains(i)) << i;
+    }
+
+    std::vector<int> visited;
+    s.inorder([&](const int& i) { visited.push_back(i); });
+    EXPECT_EQ(sorted, visited);
+}
+
+
+TEST(AVLSet_Tests, addSortedHandlesUnsortedInputAndDuplicates)
+{
+    std::vector<std::string> words{"MANGO", "APPLE", "PEAR", "APPLE", "FIG", "PEAR"};
+
+    AVLSet<std::string> s;
+    s.addSorted(words.begin(), words.end());
+
+    EXPECT_EQ(4, s.size());
+    EXPECT_EQ(2, s.height());
+
+    std::vector<std::string> visited;
+    s.inorder([&](const std::string& w) { visited.push_back(w); });
+    EXPECT_EQ((std::vector<std::string>{"APPLE", "FIG", "MANGO", "PEAR"}), visited);
+}
+
+
+TEST(AVLSet_Tests, addSortedMergesWithExistingElements)
+{
+    AVLSet<int> s;
+    s.add(5);
+    s.add(1);
+    s.add(9);
+
+    int more[] = {2, 5, 7, 8, 9, 10};
+    s.addSorted(std::begin(more), std::end(more));
+
+    EXPECT_EQ(7, s.size());
+
+    std::vector<int> visited;
+    s.inorder([&](const int& i) { visited.push_back(i); });
+    EXPECT_EQ((std::vector<int>{1, 2, 5, 7, 8, 9, 10}), visited);
+
+    // The tree is still a valid AVL tree, so adding more keeps working.
+    for (int i = 11; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(96, s.size());
+    EXPECT_LE(s.height(), 8);
+}
+
+
+TEST(AVLSet_Tests, addSortedLeavesTheSetUnchangedWhenItFails)
+{
+    AVLSet<Fragile> s;
+    Fragile sorted[] = {2, 4, 6, 8, 10, 12, 14};
+
+    // The set starts empty, so the tree is built straight from the range,
+    // and the failure comes part-way through building it.
+    Fragile::copiesLeft = 3;
+    EXPECT_THROW(s.addSorted(std::begin(sorted), std::end(sorted)), std::runtime_error);
+    EXPECT_EQ(0, s.size());
+    EXPECT_FALSE(s.contains(2));
+
+    Fragile::copiesLeft = -1;
+    s.add(5);
+    s.add(1);
+    s.add(9);
+
+    // The elements already in the set are merged with the new ones, and
+    // the failure comes part-way through copying them.
+    for (int copies = 0; copies < 12; ++copies)
+    {
+        Fragile::copiesLeft = copies;
+        EXPECT_THROW(s.addSorted(std::begin(sorted), std::end(sorted)), std::runtime_error);
+        Fragile::copiesLeft = -1;
+
+        std::vector<int> visited;
+        s.inorder([&](const Fragile& f) { visited.push_back(f.value); });
+        EXPECT_EQ((std::vector<int>{1, 5, 9}), visited) << copies;
+        EXPECT_EQ(3, s.size());
+    }
+
+    s.addSorted(std::begin(sorted), std::end(sorted));
+    EXPECT_EQ(10, s.size());
+}
+
+
+TEST(AVLSet_Tests, prefixScanVisitsOnlyMatchingElementsInOrder)
+{
+    for (bool shouldBalance : {true, false})
+    {
+        AVLSet<std::string> s{shouldBalance};
+
+        for (std::string word : {"CAT", "CATALOG", "CATS", "CAR", "DOG", "CA", "CB", "BAT", "CATERPILLAR"})
+        {
+            s.add(word);
+        }
+
+        std::vector<std::string> visited;
+        auto visit = [&](const std::string& w) { visited.push_back(w); };
+
+        EXPECT_EQ(4, s.prefixScan("CAT", 10, visit));
+        EXPECT_EQ((std::vector<std::string>{"CAT", "CATALOG", "CATERPILLAR", "CATS"}), visited);
+
+        visited.clear();
+        EXPECT_EQ(2, s.prefixScan("CA", 2, visit));
+        EXPECT_EQ((std::vector<std::string>{"CA", "CAR"}), visited);
+
+        visited.clear();
+        EXPECT_EQ(0, s.prefixScan("CAX", 10, visit));
+        EXPECT_EQ(0, s.prefixScan("E", 10, visit));
+        EXPECT_EQ(0, s.prefixScan("CAT", 0, visit));
+        EXPECT_TRUE(visited.empty());
+
+        EXPECT_EQ(9, s.prefixScan("", 100, visit));
+        EXPECT_TRUE(std::is_sorted(visited.begin(), visited.end()));
+    }
+}
+
+
+TEST(AVLSet_Tests, prefixScanIsOfferedThroughPrefixLookup)
+{
+    AVLSet<std::string> s;
+    s.add("APPLE");
+    s.add("APPLY");
+    s.add("APT");
+
+    const PrefixLookup& lookup = s;
+    std::vector<std::string> visited;
+
+    EXPECT_EQ(2, lookup.visitPrefix("APP", 5, [&](const std::string& w) { visited.push_back(w); }));
+    EXPECT_EQ((std::vector<std::string>{"APPLE", "APPLY"}), visited);
+}
+
+
+TEST(AVLSet_Tests, iteratorsVisitInTheSameOrderAsTheTraversals)
+{
+    for (bool shouldBalance : {true, false})
+    {
+        AVLSet<int> s{shouldBalance};
+
+        for (int i : {50, 20, 80, 10, 30, 70, 90, 25, 35, 5, 95, 60})
+        {
+            s.add(i);
+        }
+
+        std::vector<int> visited;
+        std::vector<int> iterated;
+
+        s.inorder([&](int i) { visited.push_back(i); });
+        std::copy(s.begin(), s.end(), std::back_inserter(iterated));
+        EXPECT_EQ(visited, iterated);
+        EXPECT_TRUE(std::is_sorted(iterated.begin(), iterated.end()));
+        EXPECT_EQ(12, iterated.size());
+
+        visited.clear();
+        iterated.clear();
+
+        s.preorder([&](int i) { visited.push_back(i); });
+        std::copy(s.preorderBegin(), s.preorderEnd(), std::back_inserter(iterated));
+        EXPECT_EQ(visited, iterated);
+        EXPECT_EQ(12, iterated.size());
+    }
+}
+
+
+TEST(AVLSet_Tests, iteratorsWorkWithStandardAlgorithmsAndStopEarly)
+{
+    AVLSet<std::string> s;
+    EXPECT_TRUE(s.begin() == s.end());
+    EXPECT_TRUE(s.preorderBegin() == s.preorderEnd());
+
+    for (std::string word : {"PEAR", "APPLE", "FIG", "PLUM", "KIWI", "DATE"})
+    {
+        s.add(word);
+    }
+
+    auto found = std::find_if(s.begin(), s.end(),
+        [](const std::string& w) { return w.size() == 4; });
+    ASSERT_TRUE(found != s.end());
+    EXPECT_EQ("DATE", *found);
+    EXPECT_EQ(4, found->size());
+
+    auto previous = found++;
+    EXPECT_EQ("DATE", *previous);
+    EXPECT_EQ("FIG", *found);
+
+    EXPECT_EQ(6, std::distance(s.begin(), s.end()));
+    EXPECT_EQ(6, std::distance(s.preorderBegin(), s.preorderEnd()));
+    EXPECT_EQ(3, std::distance(s.begin(), std::find(s.begin(), s.end(), "KIWI")));
+}
+
+
+TEST(AVLSet_Tests, containsSortedAgreesWithContains)
+{
+    for (bool shouldBalance : {true, false})
+    {
+        AVLSet<int> s{shouldBalance};
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            s.add((i * 7919) % 6000);
+        }
+
+        std::vector<int> keys;
+
+        for (int i = -5; i < 6005; i += 1 + (i & 1))
+        {
+            keys.push_back(i);
+            keys.push_back(i);
+        }
+
+        std::vector<bool> found;
+        s.containsSorted(keys.begin(), keys.end(), std::back_inserter(found));
+
+        ASSERT_EQ(keys.size(), found.size());
+
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            EXPECT_EQ(s.contains(keys[i]), found[i]) << keys[i];
+        }
+    }
+}
+
+
+TEST(AVLSet_Tests, containsSortedAcceptsViews)
+{
+    AVLSet<std::string> empty;
+    AVLSet<std::string> s;
+
+    for (std::string word : {"APPLE", "DATE", "FIG", "KIWI", "PEAR", "PLUM"})
+    {
+        s.add(word);
+    }
+
+    std::vector<std::string_view> keys{"A", "APPLE", "APPLE", "BANANA", "KIWI", "PLUM", "ZUCCHINI"};
+    bool found[7];
+
+    EXPECT_EQ(found + 7, s.containsSorted(keys.begin(), keys.end(), found));
+    EXPECT_EQ((std::vector<bool>{false, true, true, false, true, true, false}),
+        std::vector<bool>(found, found + 7));
+
+    empty.containsSorted(keys.begin(), keys.end(), found);
+    EXPECT_EQ(7, std::count(found, found + 7, false));
+}
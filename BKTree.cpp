@@ -0,0 +1,240 @@
+// BKTree.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "BKTree.hpp"
+
+
+namespace
+{
+    // The dynamic programming algorithm, used when a word is too long for
+    // Myers's algorithm to handle in one machine word.
+    unsigned int tableDistance(std::string_view a, std::string_view b)
+    {
+        std::vector<unsigned int> row(b.size() + 1);
+
+        for (unsigned int j = 0; j <= b.size(); ++j)
+        {
+            row[j] = j;
+        }
+
+        for (unsigned int i = 1; i <= a.size(); ++i)
+        {
+            unsigned int diagonal = row[0];
+            row[0] = i;
+
+            for (unsigned int j = 1; j <= b.size(); ++j)
+            {
+                unsigned int above = row[j];
+                row[j] = std::min({above + 1, row[j - 1] + 1,
+                    diagonal + (a[i - 1] == b[j - 1] ? 0u : 1u)});
+                diagonal = above;
+            }
+        }
+
+        return row[b.size()];
+    }
+}
+
+
+BKTree::Pattern::Pattern(std::string_view text)
+    : text{text}, positions{}
+{
+    if (text.size() <= 64)
+    {
+        for (unsigned int i = 0; i < text.size(); ++i)
+        {
+            positions[static_cast<unsigned char>(text[i])] |= std::uint64_t{1} << i;
+        }
+    }
+}
+
+
+unsigned int BKTree::Pattern::distanceTo(std::string_view other) const
+{
+    unsigned int m = static_cast<unsigned int>(text.size());
+
+    if (m == 0)
+    {
+        return static_cast<unsigned int>(other.size());
+    }
+    else if (m > 64)
+    {
+        return tableDistance(text, other);
+    }
+
+    // Bit i of the vertical deltas (pv for +1, mv for -1) describes how
+    // the table changes between rows i and i + 1 of the current column;
+    // the horizontal deltas (ph and mh) describe how it changes from one
+    // column to the next.  Only the score in the last row is tracked.
+    std::uint64_t last = std::uint64_t{1} << (m - 1);
+    std::uint64_t pv = m == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << m) - 1;
+    std::uint64_t mv = 0;
+    unsigned int score = m;
+
+    for (char c : other)
+    {
+        std::uint64_t eq = positions[static_cast<unsigned char>(c)];
+        std::uint64_t xv = eq | mv;
+        std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        if (ph & last)
+        {
+            score++;
+        }
+        else if (mh & last)
+        {
+            score--;
+        }
+
+        // The top row of the table counts up by one in every column, so a
+        // +1 is shifted in at the top.
+        ph = (ph << 1) | 1;
+        mh = mh << 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+
+    return score;
+}
+
+
+BKTree::BKTree()
+{
+}
+
+
+BKTree::BKTree(const std::vector<std::string>& words)
+{
+    for (const std::string& w : words)
+    {
+        add(w);
+    }
+}
+
+
+void BKTree::add(std::string_view w)
+{
+    std::uint32_t index = static_cast<std::uint32_t>(nodes.size());
+    Node node{static_cast<std::uint32_t>(characters.size()),
+              static_cast<std::uint32_t>(w.size()), NONE, NONE, 0};
+
+    if (nodes.empty())
+    {
+        characters.insert(characters.end(), w.begin(), w.end());
+        nodes.push_back(node);
+        return;
+    }
+
+    Pattern pattern{w};
+    std::uint32_t current = 0;
+
+    while (true)
+    {
+        unsigned int d = pattern.distanceTo(word(nodes[current]));
+
+        if (d == 0)
+        {
+            return;
+        }
+
+        std::uint32_t child = nodes[current].firstChild;
+
+        while (child != NONE && nodes[child].distance != d)
+        {
+            child = nodes[child].nextSibling;
+        }
+
+        if (child == NONE)
+        {
+            node.distance = d;
+            node.nextSibling = nodes[current].firstChild;
+            nodes[current].firstChild = index;
+            characters.insert(characters.end(), w.begin(), w.end());
+            nodes.push_back(node);
+            return;
+        }
+
+        current = child;
+    }
+}
+
+
+bool BKTree::contains(std::string_view w) const
+{
+    return !nodes.empty() && !findSuggestions(w, 0).empty();
+}
+
+
+unsigned int BKTree::size() const noexcept
+{
+    return static_cast<unsigned int>(nodes.size());
+}
+
+
+std::vector<std::string> BKTree::findSuggestions(std::string_view w, unsigned int maxDistance) const
+{
+    std::vector<std::pair<unsigned int, std::string_view>> found;
+
+    if (nodes.empty())
+    {
+        return {};
+    }
+
+    Pattern pattern{w};
+    std::vector<std::uint32_t> pending{0};
+
+    while (!pending.empty())
+    {
+        const Node& node = nodes[pending.back()];
+        pending.pop_back();
+
+        unsigned int d = pattern.distanceTo(word(node));
+
+        if (d <= maxDistance)
+        {
+            found.emplace_back(d, word(node));
+        }
+
+        unsigned int low = d > maxDistance ? d - maxDistance : 0;
+        unsigned int high = d + maxDistance;
+
+        for (std::uint32_t child = node.firstChild; child != NONE; child = nodes[child].nextSibling)
+        {
+            if (nodes[child].distance >= low && nodes[child].distance <= high)
+            {
+                pending.push_back(child);
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end());
+
+    std::vector<std::string> suggestions;
+    suggestions.reserve(found.size());
+
+    for (const auto& f : found)
+    {
+        suggestions.emplace_back(f.second);
+    }
+
+    return suggestions;
+}
+
+
+unsigned int BKTree::distance(std::string_view a, std::string_view b)
+{
+    return Pattern{a}.distanceTo(b);
+}
+
+
+std::string_view BKTree::word(const Node& node) const noexcept
+{
+    return std::string_view{characters.data() + node.offset, node.length};
+}
+
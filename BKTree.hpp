@@ -0,0 +1,113 @@
+// BKTree.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BKTree (Burkhard-Keller tree) is an index of words that can find every
+// word within a given edit distance of a query, for any distance, without
+// enumerating the possible edits.  WordChecker only ever looks one edit
+// away, because the number of candidate edits grows very quickly with the
+// distance; a BKTree's work instead depends on how many words it has to
+// compare against the query.
+//
+// Each node holds one word, and each of its children is labeled with a
+// distinct distance d, holding the words whose distance from the node's
+// word is d.  Because edit distance obeys the triangle inequality, a word
+// within k edits of the query can only be below the child labeled d if
+// |d - distance(query, node)| <= k, so most of the tree is never visited.
+//
+// The distance used is the Levenshtein distance (insertions, deletions and
+// replacements of single characters).  It's computed with Myers's
+// bit-parallel algorithm, which handles one whole column of the usual
+// dynamic programming table per machine operation, for words of up to 64
+// characters; longer words fall back to the dynamic programming algorithm.
+//
+// A BKTree can be built from a Set that supports traversal, e.g.,
+//
+//     BKTree tree;
+//     avlSet.inorder([&](const std::string& word) { tree.add(word); });
+
+#ifndef BKTREE_HPP
+#define BKTREE_HPP
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class BKTree
+{
+public:
+    // Initializes an empty BKTree.
+    BKTree();
+
+    // Initializes a BKTree containing the given words.
+    explicit BKTree(const std::vector<std::string>& words);
+
+
+    // add() adds a word to the tree.  If the word is already in the tree,
+    // this function has no effect.
+    void add(std::string_view word);
+
+
+    // contains() returns true if the given word is in the tree, false
+    // otherwise.
+    bool contains(std::string_view word) const;
+
+
+    // size() returns the number of words in the tree.
+    unsigned int size() const noexcept;
+
+
+    // findSuggestions() returns every word in the tree whose Levenshtein
+    // distance from the given word is at most maxDistance, ordered by
+    // their distance and then alphabetically.
+    std::vector<std::string> findSuggestions(std::string_view word, unsigned int maxDistance) const;
+
+
+    // distance() returns the Levenshtein distance between two strings.
+    static unsigned int distance(std::string_view a, std::string_view b);
+
+
+private:
+    // A Pattern holds what Myers's algorithm needs to know about one of
+    // the two strings being compared, so that it can be compared against
+    // many others without being examined again.
+    class Pattern
+    {
+    public:
+        explicit Pattern(std::string_view text);
+        unsigned int distanceTo(std::string_view other) const;
+
+    private:
+        std::string_view text;
+        std::uint64_t positions[256];
+    };
+
+
+    // The nodes are stored in one array and refer to one another by their
+    // indexes in it.  A node's children form a linked list, starting with
+    // firstChild and following nextSibling.
+    struct Node
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+        std::uint32_t firstChild;
+        std::uint32_t nextSibling;
+        std::uint32_t distance;
+    };
+
+    static constexpr std::uint32_t NONE = 0xffffffffu;
+
+    std::vector<char> characters;
+    std::vector<Node> nodes;
+
+    std::string_view word(const Node& node) const noexcept;
+};
+
+
+
+#endif // BKTREE_HPP
+
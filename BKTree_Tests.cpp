@@ -0,0 +1,139 @@
+// BKTree_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BKTree.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "BKTree.hpp"
+
+
+namespace
+{
+    unsigned int slowDistance(const std::string& a, const std::string& b)
+    {
+        std::vector<std::vector<unsigned int>> table(a.size() + 1, std::vector<unsigned int>(b.size() + 1));
+
+        for (unsigned int i = 0; i <= a.size(); ++i)
+        {
+            for (unsigned int j = 0; j <= b.size(); ++j)
+            {
+                if (i == 0 || j == 0)
+                {
+                    table[i][j] = i + j;
+                }
+                else
+                {
+                    table[i][j] = std::min({table[i - 1][j] + 1, table[i][j - 1] + 1,
+                        table[i - 1][j - 1] + (a[i - 1] == b[j - 1] ? 0 : 1)});
+                }
+            }
+        }
+
+        return table[a.size()][b.size()];
+    }
+
+
+    std::string randomWord(std::mt19937& engine, unsigned int minLength, unsigned int maxLength)
+    {
+        std::uniform_int_distribution<unsigned int> length{minLength, maxLength};
+        std::uniform_int_distribution<int> letter{'A', 'D'};
+        std::string word(length(engine), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(letter(engine));
+        }
+
+        return word;
+    }
+}
+
+
+TEST(BKTree_Tests, distanceMatchesDynamicProgramming)
+{
+    EXPECT_EQ(3, BKTree::distance("KITTEN", "SITTING"));
+    EXPECT_EQ(0, BKTree::distance("", ""));
+    EXPECT_EQ(4, BKTree::distance("", "ABCD"));
+    EXPECT_EQ(4, BKTree::distance("ABCD", ""));
+
+    std::mt19937 engine{46};
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        // Lengths on both sides of 64 exercise both algorithms.
+        std::string a = randomWord(engine, 0, i % 2 == 0 ? 12 : 80);
+        std::string b = randomWord(engine, 0, i % 2 == 0 ? 12 : 80);
+        EXPECT_EQ(slowDistance(a, b), BKTree::distance(a, b)) << a << " " << b;
+    }
+}
+
+
+TEST(BKTree_Tests, findsEveryWordWithinTheDistance)
+{
+    std::mt19937 engine{2018};
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        words.push_back(randomWord(engine, 1, 8));
+    }
+
+    BKTree tree{words};
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+    EXPECT_EQ(words.size(), tree.size());
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string query = randomWord(engine, 0, 9);
+
+        for (unsigned int k = 0; k <= 2; ++k)
+        {
+            std::vector<std::pair<unsigned int, std::string>> expected;
+
+            for (const std::string& word : words)
+            {
+                unsigned int d = slowDistance(query, word);
+
+                if (d <= k)
+                {
+                    expected.emplace_back(d, word);
+                }
+            }
+
+            std::sort(expected.begin(), expected.end());
+            std::vector<std::string> expectedWords;
+
+            for (const auto& e : expected)
+            {
+                expectedWords.push_back(e.second);
+            }
+
+            EXPECT_EQ(expectedWords, tree.findSuggestions(query, k)) << query << " " << k;
+        }
+    }
+}
+
+
+TEST(BKTree_Tests, canBeBuiltFromAnAVLSet)
+{
+    AVLSet<std::string> set;
+    set.add("CAT");
+    set.add("CART");
+    set.add("DOG");
+
+    BKTree tree;
+    set.inorder([&](const std::string& word) { tree.add(word); });
+
+    EXPECT_EQ(3, tree.size());
+    EXPECT_TRUE(tree.contains("DOG"));
+    EXPECT_FALSE(tree.contains("COG"));
+    EXPECT_EQ((std::vector<std::string>{"CAT", "CART"}), tree.findSuggestions("CAT", 1));
+}
@@ -0,0 +1,613 @@
+// BTreeSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A BTreeSet is an implementation of a Set that is a B-tree.  Rather than
+// one element and two children per node, as in an AVLSet, each node holds
+// up to MAX_KEYS elements in sorted order, and each node that isn't a leaf
+// has one more child than it has elements, with the elements in child i
+// lying between the node's elements i - 1 and i.  All of the leaves are at
+// the same depth, so the tree is always balanced.
+//
+// MAX_KEYS is chosen so that a node's elements fill about NODE_BYTES of
+// memory, i.e., a few cache lines.  Searching a node examines elements that
+// are next to one another in memory, so the cache misses in a search are
+// roughly one per level, and there are far fewer levels: a million ints
+// need only 4 levels, rather than the 20 or so of a binary tree.
+//
+// When an element is added to a leaf that's already full, the leaf is
+// split into two, and its middle element is moved up into its parent;
+// when that fills the parent, the parent splits too, and so on, until
+// perhaps the root splits and the tree grows one level taller.  The nodes
+// those splits will need are created on the way down, before any node is
+// changed, so if creating one (or copying the element) throws, the tree
+// is left as it was.
+//
+// Leaves don't need pointers to children, so they're a separate, smaller
+// type of node.  Both kinds are created and destroyed by the NodeAllocator
+// named in the BTreeSet's type (see NodePool.hpp), which defaults to a
+// NodePool.
+
+#ifndef BTREESET_HPP
+#define BTREESET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "NodePool.hpp"
+#include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+
+template <typename ElementType, template <typename> typename NodeAllocator = NodePool>
+class BTreeSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, BTreeSet<ElementType, NodeAllocator>>
+{
+public:
+    // A VisitFunction is a function that takes a reference to a const
+    // ElementType and returns no value.
+    using VisitFunction = std::function<void(const ElementType&)>;
+
+    // The number of bytes of elements that a node can hold, and the number
+    // of elements that fit into it (though never fewer than 4).
+    static constexpr std::size_t NODE_BYTES = 256;
+    static constexpr unsigned int MAX_KEYS =
+        std::max<std::size_t>(4, NODE_BYTES / sizeof(ElementType));
+
+public:
+    // Initializes a BTreeSet to be empty.
+    BTreeSet();
+
+    // Cleans up the BTreeSet so that it leaks no memory.
+    virtual ~BTreeSet() noexcept;
+
+    // Initializes a new BTreeSet to be a copy of an existing one.
+    BTreeSet(const BTreeSet& s);
+
+    // Initializes a new BTreeSet whose contents are moved from an
+    // expiring one.
+    BTreeSet(BTreeSet&& s) noexcept;
+
+    // Assigns an existing BTreeSet into another.
+    BTreeSet& operator=(const BTreeSet& s);
+
+    // Assigns an expiring BTreeSet into another.
+    BTreeSet& operator=(BTreeSet&& s) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function always runs in
+    // O(log n) time when there are n elements in the B-tree.
+    virtual void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function always runs in O(log n) time when
+    // there are n elements in the B-tree.
+    virtual bool contains(const ElementType& element) const override;
+
+
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements using == and <, such as a
+    // std::string_view when the elements are std::strings.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const noexcept override;
+
+
+    // height() returns the height of the B-tree, i.e., the number of levels
+    // below the root.  By definition, the height of an empty tree is -1.
+    int height() const noexcept;
+
+
+    // inorder() calls the given "visit" function for each of the elements
+    // in the set, in ascending order.
+    void inorder(VisitFunction visit) const;
+
+
+private:
+    // Each node has room for one more element (and child) than it's
+    // allowed to keep, so that an element can be added to a full node
+    // before the node is split.
+    struct Node
+    {
+        unsigned int count = 0;
+        bool leaf = true;
+        ElementType keys[MAX_KEYS + 1];
+    };
+
+    struct Internal : Node
+    {
+        Node* children[MAX_KEYS + 2];
+    };
+
+    // The result of adding an element to a subtree: either the element was
+    // already there, or it was added, or it was added and the subtree's
+    // root had to be split (in which case the middle element and the new
+    // node to its right are passed back up to the parent).
+    enum class Added
+    {
+        AlreadyPresent,
+        Added,
+        Split
+    };
+
+    Node* root;
+    unsigned int total_size;
+    int levels;
+    NodeAllocator<Node> leaves;
+    NodeAllocator<Internal> internals;
+
+    template <typename Key>
+    static unsigned int position_of(const Node* node, const Key& key);
+    Added insert_into(Node* node, const ElementType& element, ElementType& middle, Node*& right);
+    void split(Node* node, ElementType& middle, Node* right);
+    Node* create_like(const Node* node);
+    void destroy_node(Node* node) noexcept;
+    Node* copy_tree(const Node* node);
+    void delete_tree(Node* node) noexcept;
+    void in_ord(const Node* node, const VisitFunction& visit) const;
+};
+
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>::BTreeSet()
+    : root{nullptr}, total_size{0}, levels{0}
+{
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>::~BTreeSet() noexcept
+{
+    // As with the other Sets, a pool releases every node at once when it's
+    // destroyed, so the tree only needs to be walked if the nodes have
+    // destructors to run.
+    if constexpr (!NodeAllocator<Node>::releasesInBulk || !std::is_trivially_destructible_v<Internal>)
+    {
+        delete_tree(root);
+    }
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>::BTreeSet(const BTreeSet& s)
+    : root{nullptr}, total_size{s.total_size}, levels{s.levels}
+{
+    root = copy_tree(s.root);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>::BTreeSet(BTreeSet&& s) noexcept
+    : root{nullptr}, total_size{0}, levels{0}
+{
+    std::swap(root, s.root);
+    std::swap(total_size, s.total_size);
+    std::swap(levels, s.levels);
+    leaves.swap(s.leaves);
+    internals.swap(s.internals);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>& BTreeSet<ElementType, NodeAllocator>::operator=(const BTreeSet& s)
+{
+    if (this != &s)
+    {
+        BTreeSet copy{s};
+        *this = std::move(copy);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+BTreeSet<ElementType, NodeAllocator>& BTreeSet<ElementType, NodeAllocator>::operator=(BTreeSet&& s) noexcept
+{
+    std::swap(root, s.root);
+    std::swap(total_size, s.total_size);
+    std::swap(levels, s.levels);
+    leaves.swap(s.leaves);
+    internals.swap(s.internals);
+    return *this;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool BTreeSet<ElementType, NodeAllocator>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::add(const ElementType& element)
+{
+    if (root == nullptr)
+    {
+        root = leaves.create();
+        levels = 1;
+    }
+
+    ElementType middle;
+    Node* right;
+    Added added;
+
+    // A full root might split, in which case a new root will be needed
+    // above it, so it's created before anything else changes.
+    Internal* newRoot = nullptr;
+
+    if (root->count == MAX_KEYS)
+    {
+        newRoot = internals.create();
+        newRoot->leaf = false;
+    }
+
+    try
+    {
+        added = insert_into(root, element, middle, right);
+    }
+    catch (...)
+    {
+        destroy_node(newRoot);
+        throw;
+    }
+
+    if (added != Added::Split)
+    {
+        destroy_node(newRoot);
+    }
+
+    if (added == Added::AlreadyPresent)
+    {
+        return;
+    }
+    else if (added == Added::Split)
+    {
+        newRoot->count = 1;
+        newRoot->keys[0] = std::move(middle);
+        newRoot->children[0] = root;
+        newRoot->children[1] = right;
+        root = newRoot;
+        levels++;
+    }
+
+    total_size++;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool BTreeSet<ElementType, NodeAllocator>::contains(const ElementType& element) const
+{
+    return containsKey(element);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+bool BTreeSet<ElementType, NodeAllocator>::containsKey(const Key& key) const
+{
+    const Node* node = root;
+
+    while (node != nullptr)
+    {
+        unsigned int i = position_of(node, key);
+
+        if (i < node->count && node->keys[i] == key)
+        {
+            return true;
+        }
+        else if (node->leaf)
+        {
+            return false;
+        }
+
+        node = static_cast<const Internal*>(node)->children[i];
+    }
+
+    return false;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+unsigned int BTreeSet<ElementType, NodeAllocator>::size() const noexcept
+{
+    return total_size;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+int BTreeSet<ElementType, NodeAllocator>::height() const noexcept
+{
+    return levels - 1;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::inorder(VisitFunction visit) const
+{
+    in_ord(root, visit);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+unsigned int BTreeSet<ElementType, NodeAllocator>::position_of(const Node* node, const Key& key)
+{
+    // position_of() returns the index of the first element in the node
+    // that isn't less than the key, which is also the index of the child
+    // to descend into if the key isn't in the node.  Numbers are cheap
+    // enough to compare that counting the smaller ones, which the compiler
+    // can vectorize and which has no branches to mispredict, is faster than
+    // a binary search.
+    if constexpr (std::is_arithmetic_v<ElementType> && std::is_arithmetic_v<Key>)
+    {
+        unsigned int smaller = 0;
+
+        for (unsigned int i = 0; i < node->count; ++i)
+        {
+            smaller += node->keys[i] < key ? 1 : 0;
+        }
+
+        return smaller;
+    }
+    else
+    {
+        return static_cast<unsigned int>(
+            std::lower_bound(node->keys, node->keys + node->count, key) - node->keys);
+    }
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename BTreeSet<ElementType, NodeAllocator>::Added BTreeSet<ElementType, NodeAllocator>::insert_into(
+    Node* node, const ElementType& element, ElementType& middle, Node*& right)
+{
+    unsigned int i = position_of(node, element);
+
+    if (i < node->count && node->keys[i] == element)
+    {
+        return Added::AlreadyPresent;
+    }
+
+    // A full node splits if the element (or a middle element from below)
+    // is added to it, so the node it would split into is created before
+    // anything changes; it's destroyed again if it turns out not to be
+    // needed.  Once every such node exists, nothing below can throw.
+    if (node->leaf)
+    {
+        ElementType copy{element};
+        Node* spare = node->count == MAX_KEYS ? create_like(node) : nullptr;
+
+        std::move_backward(node->keys + i, node->keys + node->count, node->keys + node->count + 1);
+        node->keys[i] = std::move(copy);
+        node->count++;
+
+        if (spare == nullptr)
+        {
+            return Added::Added;
+        }
+
+        split(node, middle, spare);
+        right = spare;
+        return Added::Split;
+    }
+
+    Internal* internal = static_cast<Internal*>(node);
+    Node* spare = node->count == MAX_KEYS ? create_like(node) : nullptr;
+    Added added;
+
+    try
+    {
+        added = insert_into(internal->children[i], element, middle, right);
+    }
+    catch (...)
+    {
+        destroy_node(spare);
+        throw;
+    }
+
+    if (added != Added::Split)
+    {
+        destroy_node(spare);
+        return added;
+    }
+
+    std::move_backward(node->keys + i, node->keys + node->count, node->keys + node->count + 1);
+    std::move_backward(internal->children + i + 1, internal->children + node->count + 1,
+        internal->children + node->count + 2);
+    node->keys[i] = std::move(middle);
+    internal->children[i + 1] = right;
+    node->count++;
+
+    if (spare == nullptr)
+    {
+        return Added::Added;
+    }
+
+    split(node, middle, spare);
+    right = spare;
+    return Added::Split;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::split(Node* node, ElementType& middle, Node* right)
+{
+    // The node has one element too many; the elements after the middle one
+    // (and the children to the right of it) move into the given empty node,
+    // which is the same kind of node.
+    unsigned int half = node->count / 2;
+
+    if (!node->leaf)
+    {
+        std::copy(static_cast<Internal*>(node)->children + half + 1,
+            static_cast<Internal*>(node)->children + node->count + 1,
+            static_cast<Internal*>(right)->children);
+    }
+
+    std::move(node->keys + half + 1, node->keys + node->count, right->keys);
+    right->count = node->count - half - 1;
+    middle = std::move(node->keys[half]);
+    node->count = half;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename BTreeSet<ElementType, NodeAllocator>::Node* BTreeSet<ElementType, NodeAllocator>::create_like(
+    const Node* node)
+{
+    // create_like() creates an empty node of the same kind as the given one.
+    if (node->leaf)
+    {
+        return leaves.create();
+    }
+
+    Internal* internal = internals.create();
+    internal->leaf = false;
+    return internal;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::destroy_node(Node* node) noexcept
+{
+    // destroy_node() destroys one node (which may be nullptr), but none of
+    // its children.
+    if (node == nullptr)
+    {
+        return;
+    }
+    else if (node->leaf)
+    {
+        leaves.destroy(node);
+        return;
+    }
+
+    internals.destroy(static_cast<Internal*>(node));
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename BTreeSet<ElementType, NodeAllocator>::Node* BTreeSet<ElementType, NodeAllocator>::copy_tree(
+    const Node* node)
+{
+    // If copying an element or creating a node throws, the part of the
+    // copy that's already been built is destroyed, so a failed copy leaks
+    // nothing.
+    if (node == nullptr)
+    {
+        return nullptr;
+    }
+    else if (node->leaf)
+    {
+        Node* copy = leaves.create();
+
+        try
+        {
+            std::copy(node->keys, node->keys + node->count, copy->keys);
+        }
+        catch (...)
+        {
+            leaves.destroy(copy);
+            throw;
+        }
+
+        copy->count = node->count;
+        return copy;
+    }
+
+    Internal* copy = internals.create();
+    copy->leaf = false;
+    unsigned int copied = 0;
+
+    try
+    {
+        std::copy(node->keys, node->keys + node->count, copy->keys);
+
+        for (; copied <= node->count; ++copied)
+        {
+            copy->children[copied] = copy_tree(static_cast<const Internal*>(node)->children[copied]);
+        }
+    }
+    catch (...)
+    {
+        for (unsigned int i = 0; i < copied; ++i)
+        {
+            delete_tree(copy->children[i]);
+        }
+
+        internals.destroy(copy);
+        throw;
+    }
+
+    copy->count = node->count;
+    return copy;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::delete_tree(Node* node) noexcept
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+    else if (node->leaf)
+    {
+        leaves.destroy(node);
+        return;
+    }
+
+    Internal* internal = static_cast<Internal*>(node);
+
+    for (unsigned int i = 0; i <= node->count; ++i)
+    {
+        delete_tree(internal->children[i]);
+    }
+
+    internals.destroy(internal);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void BTreeSet<ElementType, NodeAllocator>::in_ord(const Node* node, const VisitFunction& visit) const
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    for (unsigned int i = 0; i < node->count; ++i)
+    {
+        if (!node->leaf)
+        {
+            in_ord(static_cast<const Internal*>(node)->children[i], visit);
+        }
+
+        visit(node->keys[i]);
+    }
+
+    if (!node->leaf)
+    {
+        in_ord(static_cast<const Internal*>(node)->children[node->count], visit);
+    }
+}
+
+
+
+#endif // BTREESET_HPP
+
@@ -0,0 +1,86 @@
+// BTreeSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing BTreeSet with AVLSet.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BTreeSet.hpp"
+#include "Benchmark.hpp"
+
+
+namespace
+{
+    // Adds the elements to an empty set, then looks up a shuffled mix of
+    // the elements and the missing ones, reporting the throughput of each.
+    template <typename SetType, typename ElementType>
+    void measureSet(
+        const char* label, const std::vector<ElementType>& elements,
+        const std::vector<ElementType>& queries)
+    {
+        bench::Stopwatch watch;
+        SetType set;
+
+        for (const ElementType& element : elements)
+        {
+            set.add(element);
+        }
+
+        double addNs = bench::nanosPerOperation(watch, elements.size());
+        unsigned int found = 0;
+        watch.restart();
+
+        for (const ElementType& query : queries)
+        {
+            found += set.contains(query) ? 1 : 0;
+        }
+
+        double lookupNs = bench::nanosPerOperation(watch, queries.size());
+        bench::doNotOptimize(found);
+
+        std::printf("  %-10s add %6.1f ns (%5.2f M/s)  contains %6.1f ns (%5.2f M/s)  height %d\n",
+            label, addNs, 1000.0 / addNs, lookupNs, 1000.0 / lookupNs, set.height());
+    }
+
+
+    template <typename ElementType>
+    void compareSets(
+        const char* kind, const std::vector<ElementType>& elements,
+        const std::vector<ElementType>& missing)
+    {
+        std::vector<ElementType> queries = elements;
+        queries.insert(queries.end(), missing.begin(), missing.end());
+        std::shuffle(queries.begin(), queries.end(), std::mt19937{21});
+
+        std::printf("  %zu %s\n", elements.size(), kind);
+        measureSet<AVLSet<ElementType>>("AVLSet", elements, queries);
+        measureSet<BTreeSet<ElementType>>("BTreeSet", elements, queries);
+    }
+}
+
+
+BENCHMARK(BTreeSet, versusAVLSet)
+{
+    for (unsigned int size : {100000u, 1000000u})
+    {
+        std::vector<unsigned int> numbers;
+        std::vector<unsigned int> missingNumbers;
+        std::mt19937 engine{size};
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            // Even numbers are in the set and odd numbers aren't.
+            numbers.push_back(engine() & ~1u);
+            missingNumbers.push_back(engine() | 1u);
+        }
+
+        compareSets("ints", numbers, missingNumbers);
+        compareSets("words", bench::makeWords(size, 16), bench::makeWords(size, 17));
+    }
+}
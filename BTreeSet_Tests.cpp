@@ -0,0 +1,334 @@
+// BTreeSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for BTreeSet.
+
+#include <algorithm>
+#include <new>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BTreeSet.hpp"
+#include "NodePool.hpp"
+#include "WordChecker.hpp"
+
+
+
+namespace
+{
+    // A NodeAllocator whose create() starts throwing once nodesLeft reaches
+    // zero, so that an add() can be made to fail while splitting.
+    int nodesLeft = -1;
+
+    template <typename Node>
+    class FailingNodes : public HeapNodes<Node>
+    {
+    public:
+        template <typename... Args>
+        Node* create(Args&&... args)
+        {
+            if (nodesLeft == 0)
+            {
+                throw std::bad_alloc{};
+            }
+            else if (nodesLeft > 0)
+            {
+                --nodesLeft;
+            }
+
+            return HeapNodes<Node>::create(std::forward<Args>(args)...);
+        }
+    };
+
+
+    // An element whose copies start throwing once copiesLeft reaches zero;
+    // moving one never throws.
+    struct Fragile
+    {
+        static int copiesLeft;
+
+        int value = 0;
+
+        Fragile() = default;
+
+        Fragile(int value)
+            : value{value}
+        {
+        }
+
+        Fragile(const Fragile& other)
+            : value{other.value}
+        {
+            countCopy();
+        }
+
+        Fragile(Fragile&& other) noexcept = default;
+
+        Fragile& operator=(const Fragile& other)
+        {
+            countCopy();
+            value = other.value;
+            return *this;
+        }
+
+        Fragile& operator=(Fragile&& other) noexcept = default;
+
+        bool operator<(const Fragile& other) const { return value < other.value; }
+        bool operator==(const Fragile& other) const { return value == other.value; }
+
+        static void countCopy()
+        {
+            if (copiesLeft == 0)
+            {
+                throw std::runtime_error{"copy failed"};
+            }
+            else if (copiesLeft > 0)
+            {
+                --copiesLeft;
+            }
+        }
+    };
+
+    int Fragile::copiesLeft = -1;
+}
+
+
+TEST(BTreeSet_Tests, emptyTreeHasNoElements)
+{
+    BTreeSet<int> s;
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(-1, s.height());
+    EXPECT_FALSE(s.contains(0));
+}
+
+
+TEST(BTreeSet_Tests, containsTheSameElementsAsAStdSet)
+{
+    std::mt19937 engine{46};
+    std::set<int> expected;
+    BTreeSet<int> s;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int value = static_cast<int>(engine() % 50000);
+        expected.insert(value);
+        s.add(value);
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        EXPECT_EQ(expected.count(i) == 1, s.contains(i)) << i;
+    }
+
+    std::vector<int> visited;
+    s.inorder([&](const int& i) { visited.push_back(i); });
+    EXPECT_EQ(std::vector<int>(expected.begin(), expected.end()), visited);
+}
+
+
+TEST(BTreeSet_Tests, nodesHoldManyElements)
+{
+    BTreeSet<int> s;
+
+    for (unsigned int i = 0; i < BTreeSet<int>::MAX_KEYS; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(0, s.height());
+
+    s.add(-1);
+    EXPECT_EQ(1, s.height());
+
+    for (int i = 0; i < 100000; ++i)
+    {
+        s.add(i);
+    }
+
+    // Every node but the root is at least half full.
+    EXPECT_LE(s.height(), 3);
+}
+
+
+TEST(BTreeSet_Tests, smallNodesSplitCorrectlyInEveryOrder)
+{
+    // Strings are large enough that a node holds only a few of them, so
+    // this splits nodes at every level many times.
+    for (int order = 0; order < 3; ++order)
+    {
+        std::vector<std::string> words;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            words.push_back("WORD" + std::to_string(1000000 + i));
+        }
+
+        if (order == 1)
+        {
+            std::reverse(words.begin(), words.end());
+        }
+        else if (order == 2)
+        {
+            std::shuffle(words.begin(), words.end(), std::mt19937{2018});
+        }
+
+        BTreeSet<std::string, HeapNodes> s;
+
+        for (const std::string& word : words)
+        {
+            s.add(word);
+            s.add(word);
+        }
+
+        EXPECT_EQ(2000, s.size());
+
+        std::vector<std::string> visited;
+        s.inorder([&](const std::string& w) { visited.push_back(w); });
+        std::sort(words.begin(), words.end());
+        EXPECT_EQ(words, visited);
+    }
+}
+
+
+TEST(BTreeSet_Tests, copiesAndMovesKeepEveryElement)
+{
+    BTreeSet<int> s;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i * 7 % 1000);
+    }
+
+    BTreeSet<int> copy{s};
+    BTreeSet<int> assigned;
+    assigned.add(5000);
+    assigned = s;
+    BTreeSet<int> moved{std::move(copy)};
+
+    for (const BTreeSet<int>* t : {&assigned, &moved})
+    {
+        EXPECT_EQ(1000, t->size());
+        EXPECT_EQ(s.height(), t->height());
+        EXPECT_FALSE(t->contains(5000));
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            EXPECT_TRUE(t->contains(i));
+        }
+    }
+}
+
+
+TEST(BTreeSet_Tests, failingToCreateANodeLeavesTheTreeUnchanged)
+{
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        words.push_back("WORD" + std::to_string(1000000 + i));
+    }
+
+    std::shuffle(words.begin(), words.end(), std::mt19937{46});
+    BTreeSet<std::string, FailingNodes> s;
+    unsigned int failures = 0;
+
+    // Each word is first added when no node can be created, which fails
+    // whenever the word would split a node, and then added for real.
+    for (unsigned int i = 0; i < words.size(); ++i)
+    {
+        nodesLeft = 0;
+
+        try
+        {
+            s.add(words[i]);
+        }
+        catch (std::bad_alloc&)
+        {
+            failures++;
+            EXPECT_EQ(i, s.size());
+            EXPECT_FALSE(s.contains(words[i]));
+        }
+
+        nodesLeft = -1;
+        s.add(words[i]);
+        ASSERT_EQ(i + 1, s.size());
+    }
+
+    EXPECT_GT(failures, 0u);
+
+    std::vector<std::string> visited;
+    s.inorder([&](const std::string& w) { visited.push_back(w); });
+    std::sort(words.begin(), words.end());
+    EXPECT_EQ(words, visited);
+}
+
+
+TEST(BTreeSet_Tests, failingToCopyAnElementLeavesTheTreeUnchanged)
+{
+    BTreeSet<Fragile> s;
+    std::vector<int> expected;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        int value = i * 7 % 500;
+
+        Fragile::copiesLeft = 0;
+        EXPECT_THROW(s.add(value), std::runtime_error);
+        Fragile::copiesLeft = -1;
+        ASSERT_EQ(static_cast<unsigned int>(i), s.size());
+
+        s.add(value);
+        expected.push_back(value);
+    }
+
+    std::sort(expected.begin(), expected.end());
+
+    BTreeSet<Fragile> assigned;
+    assigned.add(-1);
+
+    for (int copies : {0, 1, 64, 300, 499})
+    {
+        Fragile::copiesLeft = copies;
+        EXPECT_THROW(assigned = s, std::runtime_error);
+        Fragile::copiesLeft = -1;
+
+        EXPECT_EQ(1, assigned.size());
+        EXPECT_TRUE(assigned.contains(-1));
+        EXPECT_FALSE(assigned.contains(0));
+    }
+
+    assigned = s;
+
+    for (const BTreeSet<Fragile>* t : {&s, &assigned})
+    {
+        std::vector<int> visited;
+        t->inorder([&](const Fragile& f) { visited.push_back(f.value); });
+        EXPECT_EQ(expected, visited);
+    }
+}
+
+
+TEST(BTreeSet_Tests, canBeUsedByAWordChecker)
+{
+    BTreeSet<std::string> s;
+    s.add("CAT");
+    s.add("CART");
+    s.add("AT");
+
+    WordChecker checker{s};
+    const StringViewLookup& lookup = s;
+
+    EXPECT_TRUE(checker.wordExists("CART"));
+    EXPECT_FALSE(checker.wordExists("CAR"));
+    EXPECT_TRUE(lookup.containsView(std::string_view{"CATS"}.substr(1, 2)));
+}
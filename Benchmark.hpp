@@ -0,0 +1,187 @@
+// Benchmark.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A very small benchmarking harness, laid out the same way as the unit
+// tests: each *_Benchmarks.cpp file registers its benchmarks using the
+// BENCHMARK() macro below, and benchmain.cpp runs all of them (or only
+// the ones whose names contain the command-line arguments).
+//
+// Along with the registry, this file provides the handful of utilities
+// the benchmarks share: a stopwatch, a generator for synthetic
+// dictionaries of uppercase words, a string hash function suitable for
+// handing to the hash-based sets, and a way to keep the optimizer from
+// discarding the results of the work being measured.
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+
+namespace bench
+{
+    // A Benchmark is a named function that measures something and
+    // reports its own results.
+    struct Benchmark
+    {
+        std::string name;
+        std::function<void()> run;
+    };
+
+
+    // benchmarks() returns the registry of every benchmark that has been
+    // registered with BENCHMARK().
+    inline std::vector<Benchmark>& benchmarks()
+    {
+        static std::vector<Benchmark> registry;
+        return registry;
+    }
+
+
+    struct Registrar
+    {
+        Registrar(const std::string& name, std::function<void()> run)
+        {
+            benchmarks().push_back(Benchmark{name, std::move(run)});
+        }
+    };
+
+
+    // A Stopwatch measures the wall-clock time that has elapsed since it
+    // was created or last restarted.
+    class Stopwatch
+    {
+    public:
+        Stopwatch()
+            : start{std::chrono::steady_clock::now()}
+        {
+        }
+
+        void restart()
+        {
+            start = std::chrono::steady_clock::now();
+        }
+
+        double elapsedMilliseconds() const
+        {
+            return std::chrono::duration<double, std::milli>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+        double elapsedNanoseconds() const
+        {
+            return std::chrono::duration<double, std::nano>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+    private:
+        std::chrono::steady_clock::time_point start;
+    };
+
+
+    // makeWords() returns the given number of distinct words made up of
+    // the letters 'A' through 'Z', with lengths between minLength and
+    // maxLength.  The same seed always produces the same words.
+    inline std::vector<std::string> makeWords(
+        unsigned int count, unsigned int seed,
+        unsigned int minLength = 3, unsigned int maxLength = 12)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<unsigned int> length{minLength, maxLength};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+
+        std::unordered_set<std::string> seen;
+        std::vector<std::string> words;
+        words.reserve(count);
+
+        while (words.size() < count)
+        {
+            std::string word(length(engine), ' ');
+
+            for (char& c : word)
+            {
+                c = static_cast<char>(letter(engine));
+            }
+
+            if (seen.insert(word).second)
+            {
+                words.push_back(std::move(word));
+            }
+        }
+
+        return words;
+    }
+
+
+    // stringHash() is a 32-bit FNV-1a hash, which is what the benchmarks
+    // hand to sets that require a hash function.
+    inline unsigned int stringHash(const std::string& s)
+    {
+        unsigned int hash = 2166136261u;
+
+        for (unsigned char c : s)
+        {
+            hash = (hash ^ c) * 16777619u;
+        }
+
+        return hash;
+    }
+
+
+    // doNotOptimize() forces the compiler to assume that the given value
+    // is used, so that the work that produced it can't be optimized away.
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+
+    // allocationCount() returns the number of times the global operator
+    // new has been called since the program started.  It is maintained by
+    // the replacement operator new in benchmain.cpp.
+    std::size_t allocationCount() noexcept;
+
+
+    // liveBytes() returns the number of bytes currently allocated through
+    // the global operator new (as the allocator rounds them up), so the
+    // difference between two calls is the memory held by whatever was
+    // built in between.
+    std::size_t liveBytes() noexcept;
+
+
+    // nanosPerOperation() is a small convenience for turning a total time
+    // into an average cost.
+    inline double nanosPerOperation(const Stopwatch& watch, std::size_t operations)
+    {
+        return operations == 0 ? 0.0 : watch.elapsedNanoseconds() / operations;
+    }
+}
+
+
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+
+// BENCHMARK(Group, Name) defines and registers a benchmark called
+// "Group.Name", much like Google Test's TEST() macro.
+#define BENCHMARK(group, name) \
+    static void BENCHMARK_CONCAT(group##_##name, _benchmark)(); \
+    static bench::Registrar BENCHMARK_CONCAT(group##_##name, _registrar){ \
+        #group "." #name, BENCHMARK_CONCAT(group##_##name, _benchmark)}; \
+    static void BENCHMARK_CONCAT(group##_##name, _benchmark)()
+
+
+
+#endif // BENCHMARK_HPP
+
@@ -0,0 +1,442 @@
+// ConcurrentSkipListSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A ConcurrentSkipListSet is a skip list, like a SkipListSet, that any
+// number of threads can add to and search at the same time, without a
+// lock, e.g., so that a WordChecker can keep checking words on many
+// threads while new words are added to its dictionary.
+//
+// Like SkipListSet's, each node contains only two pointers: one to the
+// node that follows it on the same level and one to the equivalent node on
+// the level below it.  The "next" pointers are atomic, and a node is added
+// to a level with a single compare-and-swap of its predecessor's "next"
+// pointer, which only succeeds if nothing else was added there since the
+// predecessor was found; if something was, the search resumes from the
+// predecessor and tries again.  An element is in the set as soon as its
+// node on the bottom level has been added; its nodes on higher levels are
+// added afterward, one level at a time, and only make searches faster.
+//
+// contains() never writes anything and never waits for another thread: it
+// follows pointers that are only ever changed to point to nodes that are
+// fully constructed, and because elements are never removed, the nodes it
+// follows are never destroyed out from under it.  For the same reason,
+// memory reclamation is simple: the nodes are only destroyed when the set
+// is, at which point no other thread may be using it.
+//
+// The level tester passed to the constructor isn't expected to be safe to
+// call from more than one thread at a time, so calls to it are serialized
+// by a mutex.  When no level tester is given, the levels are decided by a
+// random number generator belonging to each thread instead, and add() is
+// lock-free.
+//
+// There are at most MAX_LEVELS levels; an element that would be promoted
+// further than that stays on the top level.  ConcurrentSkipListSets can't
+// be copied or moved, since other threads may be using them.
+
+#ifndef CONCURRENTSKIPLISTSET_HPP
+#define CONCURRENTSKIPLISTSET_HPP
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include "Set.hpp"
+#include "SkipListSet.hpp"
+#include "StringLookup.hpp"
+
+
+
+template <typename ElementType>
+class ConcurrentSkipListSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, ConcurrentSkipListSet<ElementType>>,
+    public OrderedLookup<ElementType, ConcurrentSkipListSet<ElementType>>
+{
+public:
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+public:
+    // Initializes a ConcurrentSkipListSet to be empty, with or without a
+    // "level tester" object that will decide whether each element should
+    // occupy the next level above.
+    ConcurrentSkipListSet();
+    explicit ConcurrentSkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester);
+
+    // Cleans up the ConcurrentSkipListSet so that it leaks no memory.
+    // No other thread may be using the set when it's destroyed.
+    virtual ~ConcurrentSkipListSet() noexcept;
+
+    ConcurrentSkipListSet(const ConcurrentSkipListSet&) = delete;
+    ConcurrentSkipListSet& operator=(const ConcurrentSkipListSet&) = delete;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set (or another thread is adding it at the same time), this function
+    // has no effect.  It's safe to call from any number of threads at
+    // once, and runs in an expected time of O(log n), plus the time spent
+    // retrying when other threads add elements in the same places.
+    virtual void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  An element whose add() has returned is always found; one
+    // being added by another thread may or may not be.  It's safe to call
+    // from any number of threads at once, and runs in an expected time of
+    // O(log n) without waiting for any other thread.
+    virtual bool contains(const ElementType& element) const override;
+
+
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements, such as a std::string_view when the
+    // elements are std::strings.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
+    // size() returns the number of elements in the set.  While other
+    // threads are adding to it, this can be out of date by the time it's
+    // returned.
+    virtual unsigned int size() const noexcept override;
+
+
+    // levelCount(), elementsOnLevel(), and isElementOnLevel() are the same
+    // as SkipListSet's.  They're meant for testing, and their results
+    // aren't meaningful while other threads are adding to the set.
+    unsigned int levelCount() const noexcept;
+    unsigned int elementsOnLevel(unsigned int level) const noexcept;
+    bool isElementOnLevel(const ElementType& element, unsigned int level) const;
+
+
+    // prefixScan() is the same as SkipListSet's, and can be called while
+    // other threads are adding to the set.  Elements being added while
+    // the scan runs may or may not be visited.
+    template <typename Visitor>
+    unsigned int prefixScan(std::string_view prefix, unsigned int limit, Visitor&& visit) const;
+
+
+private:
+    struct Node
+    {
+        ElementType element;
+        std::atomic<Node*> next;
+        Node* down;
+    };
+
+    // heads[i] is the -INF node on level i; they're never compared to
+    // anything, so their elements are default-constructed.
+    Node heads[MAX_LEVELS];
+
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+    std::mutex levelTesterMutex;
+
+    // The number of levels that searches begin above, which only grows.
+    std::atomic<unsigned int> levels;
+    std::atomic<unsigned int> count;
+
+    template <typename Key>
+    const Node* first_not_less(const Key& key) const;
+
+    unsigned int choose_height(const ElementType& element);
+    Node* link(Node* left, Node* node);
+};
+
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet()
+    : ConcurrentSkipListSet{nullptr}
+{
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::ConcurrentSkipListSet(
+    std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelTester{std::move(levelTester)}, levels{1}, count{0}
+{
+    for (unsigned int level = 0; level < MAX_LEVELS; level++)
+    {
+        heads[level].next.store(nullptr, std::memory_order_relaxed);
+        heads[level].down = level > 0 ? &heads[level - 1] : nullptr;
+    }
+}
+
+
+template <typename ElementType>
+ConcurrentSkipListSet<ElementType>::~ConcurrentSkipListSet() noexcept
+{
+    for (Node& head : heads)
+    {
+        Node* n = head.next.load(std::memory_order_relaxed);
+
+        while (n != nullptr)
+        {
+            Node* next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void ConcurrentSkipListSet<ElementType>::add(const ElementType& element)
+{
+    // The search records, on every level, the last node whose element is
+    // less than the new one; those are where the new nodes will go.
+    Node* left[MAX_LEVELS];
+    unsigned int top = levels.load(std::memory_order_acquire);
+
+    for (unsigned int level = MAX_LEVELS; level-- > top;)
+    {
+        left[level] = &heads[level];
+    }
+
+    Node* n = &heads[top - 1];
+
+    for (unsigned int level = top; level-- > 0;)
+    {
+        Node* next = n->next.load(std::memory_order_acquire);
+
+        while (next != nullptr && next->element < element)
+        {
+            n = next;
+            next = n->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr && next->element == element)
+        {
+            return;
+        }
+
+        left[level] = n;
+        n = n->down;
+    }
+
+    // The element is in the set once it's on the bottom level, unless
+    // another thread gets it there first.
+    Node* below = link(left[0], new Node{element, {nullptr}, nullptr});
+
+    if (below == nullptr)
+    {
+        return;
+    }
+
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    unsigned int height = choose_height(element);
+
+    for (unsigned int seen = top; seen < height
+         && !levels.compare_exchange_weak(seen, height, std::memory_order_acq_rel);)
+    {
+    }
+
+    for (unsigned int level = 1; level < height; level++)
+    {
+        below = link(left[level], new Node{element, {nullptr}, below});
+    }
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::contains(const ElementType& element) const
+{
+    return containsKey(element);
+}
+
+
+template <typename ElementType>
+template <typename Key>
+bool ConcurrentSkipListSet<ElementType>::containsKey(const Key& key) const
+{
+    const Node* found = first_not_less(key);
+    return found != nullptr && found->element == key;
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::size() const noexcept
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::levelCount() const noexcept
+{
+    return levels.load(std::memory_order_acquire);
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+{
+    unsigned int onLevel = 0;
+
+    if (level < levelCount())
+    {
+        for (const Node* n = heads[level].next.load(std::memory_order_acquire); n != nullptr;
+             n = n->next.load(std::memory_order_acquire))
+        {
+            onLevel++;
+        }
+    }
+
+    return onLevel;
+}
+
+
+template <typename ElementType>
+bool ConcurrentSkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    if (level >= levelCount())
+    {
+        return false;
+    }
+
+    const Node* n = heads[level].next.load(std::memory_order_acquire);
+
+    while (n != nullptr && n->element < element)
+    {
+        n = n->next.load(std::memory_order_acquire);
+    }
+
+    return n != nullptr && n->element == element;
+}
+
+
+template <typename ElementType>
+template <typename Visitor>
+unsigned int ConcurrentSkipListSet<ElementType>::prefixScan(
+    std::string_view prefix, unsigned int limit, Visitor&& visit) const
+{
+    unsigned int visited = 0;
+
+    for (const Node* n = first_not_less(prefix);
+         visited < limit && n != nullptr; n = n->next.load(std::memory_order_acquire))
+    {
+        if (std::string_view{n->element}.substr(0, prefix.size()) != prefix)
+        {
+            break;
+        }
+
+        visit(n->element);
+        visited++;
+    }
+
+    return visited;
+}
+
+
+template <typename ElementType>
+template <typename Key>
+const typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::first_not_less(
+    const Key& key) const
+{
+    // Returns the node on the bottom level with the smallest element not
+    // less than the key, or nullptr (+INF) if there isn't one.
+    //
+    // The node returned is the one that was seen to stop the search, not
+    // whatever follows its predecessor by the time the search has stopped;
+    // another thread may have added a smaller element there in between,
+    // which would hide the one being looked for.
+    const Node* n = &heads[levels.load(std::memory_order_acquire) - 1];
+
+    while (true)
+    {
+        const Node* next = n->next.load(std::memory_order_acquire);
+
+        while (next != nullptr && next->element < key)
+        {
+            n = next;
+            next = n->next.load(std::memory_order_acquire);
+        }
+
+        if (n->down == nullptr)
+        {
+            return next;
+        }
+
+        n = n->down;
+    }
+}
+
+
+template <typename ElementType>
+unsigned int ConcurrentSkipListSet<ElementType>::choose_height(const ElementType& element)
+{
+    unsigned int height = 1;
+
+    if (levelTester != nullptr)
+    {
+        std::lock_guard<std::mutex> lock{levelTesterMutex};
+
+        while (height < MAX_LEVELS && levelTester->shouldOccupyNextLevel(element))
+        {
+            height++;
+        }
+    }
+    else
+    {
+        // Each bit of a random number is a coin flip, so the number of
+        // trailing 1 bits has the same distribution as the number of
+        // flips that come up heads before the first tails.
+        static thread_local std::minstd_rand engine{std::random_device{}()};
+        unsigned long flips = ~static_cast<unsigned long>(engine()) | (1ul << (MAX_LEVELS - 1));
+        height += __builtin_ctzl(flips);
+    }
+
+    return height;
+}
+
+
+template <typename ElementType>
+typename ConcurrentSkipListSet<ElementType>::Node* ConcurrentSkipListSet<ElementType>::link(Node* left, Node* node)
+{
+    // Adds the node to the level after "left", which was the last node with
+    // an element less than the node's when it was found.  Because nothing
+    // is ever removed, if other threads have added nodes after "left" since
+    // then, the right place is still after "left", so the search resumes
+    // from there.  Returns the node, or nullptr (having deleted it) if
+    // another thread added the same element to this level first.
+    Node* next = left->next.load(std::memory_order_acquire);
+
+    while (true)
+    {
+        while (next != nullptr && next->element < node->element)
+        {
+            left = next;
+            next = left->next.load(std::memory_order_acquire);
+        }
+
+        if (next != nullptr && next->element == node->element)
+        {
+            delete node;
+            return nullptr;
+        }
+
+        node->next.store(next, std::memory_order_relaxed);
+
+        if (left->next.compare_exchange_weak(
+                next, node, std::memory_order_release, std::memory_order_acquire))
+        {
+            return node;
+        }
+    }
+}
+
+
+
+#endif // CONCURRENTSKIPLISTSET_HPP
@@ -0,0 +1,142 @@
+// ConcurrentSkipListSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks measuring how lookups in a ConcurrentSkipListSet scale with
+// the number of reading threads while another thread adds to it, compared
+// with a SkipListSet protected by a reader-writer lock.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "ConcurrentSkipListSet.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // A SkipListSet behind a global reader-writer lock, which is how the
+    // other Set implementations would have to be shared.
+    class LockedSkipListSet
+    {
+    public:
+        void add(const std::string& element)
+        {
+            std::unique_lock<std::shared_mutex> lock{mutex};
+            set.add(element);
+        }
+
+        bool contains(const std::string& element) const
+        {
+            std::shared_lock<std::shared_mutex> lock{mutex};
+            return set.contains(element);
+        }
+
+    private:
+        mutable std::shared_mutex mutex;
+        SkipListSet<std::string> set;
+    };
+
+
+    // Runs the given number of reader threads, each looking up the queries
+    // over and over, alongside one writer thread adding the new words, for
+    // a fixed length of time; reports the total lookups per second and
+    // the number of words the writer added.
+    template <typename SetType>
+    void measureReaders(
+        const char* label, unsigned int readers,
+        const std::vector<std::string>& dictionary,
+        const std::vector<std::string>& newWords,
+        const std::vector<std::string>& queries)
+    {
+        SetType set;
+
+        for (const std::string& word : dictionary)
+        {
+            set.add(word);
+        }
+
+        std::atomic<bool> stop{false};
+        std::atomic<unsigned long> lookups{0};
+        std::atomic<unsigned int> added{0};
+        std::vector<std::thread> threads;
+
+        for (unsigned int t = 0; t < readers; ++t)
+        {
+            threads.emplace_back([&, t]
+            {
+                unsigned long done = 0;
+                unsigned int found = 0;
+
+                for (std::size_t i = t * 7919; !stop.load(std::memory_order_relaxed); ++i, ++done)
+                {
+                    found += set.contains(queries[i % queries.size()]) ? 1 : 0;
+                }
+
+                bench::doNotOptimize(found);
+                lookups += done;
+            });
+        }
+
+        threads.emplace_back([&]
+        {
+            for (std::size_t i = 0; i < newWords.size() && !stop.load(std::memory_order_relaxed); ++i)
+            {
+                set.add(newWords[i]);
+                added++;
+            }
+        });
+
+        bench::Stopwatch watch;
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+        stop = true;
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        double seconds = watch.elapsedMilliseconds() / 1000.0;
+
+        std::printf("    %-26s %2u readers  %8.2f M lookups/s  %7u words added\n",
+            label, readers, lookups / seconds / 1e6, added.load());
+    }
+}
+
+
+BENCHMARK(ConcurrentSkipListSet, readerScaling)
+{
+    std::vector<std::string> dictionary = bench::makeWords(200000, 20);
+    std::vector<std::string> newWords = bench::makeWords(200000, 21);
+
+    std::vector<std::string> queries = dictionary;
+    queries.resize(100000);
+    std::vector<std::string> missing = bench::makeWords(100000, 22);
+    queries.insert(queries.end(), missing.begin(), missing.end());
+    std::shuffle(queries.begin(), queries.end(), std::mt19937{23});
+
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  %u hardware threads\n", cores);
+
+    for (unsigned int readers = 1; ; readers = std::min(readers * 2, cores))
+    {
+        measureReaders<ConcurrentSkipListSet<std::string>>(
+            "ConcurrentSkipListSet", readers, dictionary, newWords, queries);
+        measureReaders<LockedSkipListSet>(
+            "SkipListSet + shared_mutex", readers, dictionary, newWords, queries);
+
+        if (readers == cores)
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,193 @@
+// ConcurrentSkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for ConcurrentSkipListSet, including stress tests that add
+// to and search it from several threads at once.
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ConcurrentSkipListSet.hpp"
+
+
+namespace
+{
+    // Promotes an int once for each trailing zero bit it has (so 0 is
+    // never promoted), which makes the shape of the skip list depend only
+    // on which elements are in it.
+    class TrailingZerosLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        virtual bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element != current)
+            {
+                current = element;
+                flips = 0;
+            }
+
+            flips++;
+            return element != 0 && element % (1 << flips) == 0;
+        }
+
+        virtual std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<TrailingZerosLevelTester>();
+        }
+
+    private:
+        int current = -1;
+        int flips = 0;
+    };
+
+
+    const unsigned int THREADS = 4;
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, levelsFollowTheLevelTester)
+{
+    ConcurrentSkipListSet<int> s{std::make_unique<TrailingZerosLevelTester>()};
+
+    for (int i : {8, 3, 1, 6, 4, 7, 2, 5, 8, 4})
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(8, s.size());
+    EXPECT_EQ(4, s.levelCount());
+    EXPECT_EQ(8, s.elementsOnLevel(0));
+    EXPECT_EQ(4, s.elementsOnLevel(1));
+    EXPECT_EQ(2, s.elementsOnLevel(2));
+    EXPECT_EQ(1, s.elementsOnLevel(3));
+    EXPECT_TRUE(s.isElementOnLevel(8, 3));
+    EXPECT_FALSE(s.isElementOnLevel(6, 2));
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_FALSE(s.contains(9));
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, threadsAddingOverlappingElementsAddEachOnce)
+{
+    ConcurrentSkipListSet<int> s;
+    std::vector<std::thread> threads;
+
+    // Each thread adds every multiple of 1 through 4 below 40000, starting
+    // at a different place, so the threads collide often.
+    for (unsigned int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back([&s, t]
+        {
+            for (int i = 0; i < 40000; ++i)
+            {
+                int value = (i + static_cast<int>(t) * 10000) % 40000;
+
+                if (value % (t + 1) == 0)
+                {
+                    s.add(value);
+                }
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(40000, s.size());
+    EXPECT_EQ(40000, s.elementsOnLevel(0));
+
+    for (int i = 0; i < 40000; ++i)
+    {
+        EXPECT_TRUE(s.contains(i)) << i;
+    }
+
+    EXPECT_FALSE(s.contains(-1));
+    EXPECT_FALSE(s.contains(40000));
+
+    for (unsigned int level = 1; level < s.levelCount(); ++level)
+    {
+        EXPECT_LE(s.elementsOnLevel(level), s.elementsOnLevel(level - 1));
+    }
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, readersSeeEveryElementThatHasBeenAdded)
+{
+    ConcurrentSkipListSet<std::string> s;
+    std::atomic<int> added{0};
+    std::atomic<int> misses{0};
+    const int count = 20000;
+
+    std::thread writer{[&]
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            s.add("WORD" + std::to_string(i));
+            added.store(i + 1, std::memory_order_release);
+        }
+    }};
+
+    std::vector<std::thread> readers;
+
+    for (unsigned int t = 0; t < THREADS; ++t)
+    {
+        readers.emplace_back([&, t]
+        {
+            for (unsigned int round = 0; added.load(std::memory_order_acquire) < count; ++round)
+            {
+                int known = added.load(std::memory_order_acquire);
+                int i = known > 0 ? static_cast<int>((round * 7919u + t) % known) : 0;
+
+                if (known > 0 && !s.contains("WORD" + std::to_string(i)))
+                {
+                    misses++;
+                }
+
+                if (s.contains("NOTAWORD" + std::to_string(i)))
+                {
+                    misses++;
+                }
+            }
+        });
+    }
+
+    writer.join();
+
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(0, misses.load());
+    EXPECT_EQ(count, s.size());
+}
+
+
+TEST(ConcurrentSkipListSet_Tests, offersViewAndPrefixLookups)
+{
+    ConcurrentSkipListSet<std::string> s;
+
+    for (std::string word : {"CAT", "CATALOG", "CATS", "CAR", "DOG", "CA", "BAT"})
+    {
+        s.add(word);
+    }
+
+    std::string text = "BOOCATS";
+    const StringViewLookup& lookup = s;
+    EXPECT_TRUE(lookup.containsView(std::string_view{text}.substr(3)));
+    EXPECT_FALSE(lookup.containsView(std::string_view{text}.substr(0, 3)));
+
+    const PrefixLookup& prefixes = s;
+    std::vector<std::string> visited;
+
+    EXPECT_EQ(3, prefixes.visitPrefix("CAT", 10, [&](const std::string& w) { visited.push_back(w); }));
+    EXPECT_EQ((std::vector<std::string>{"CAT", "CATALOG", "CATS"}), visited);
+}
@@ -0,0 +1,314 @@
+// DeletionIndex.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "DeletionIndex.hpp"
+#include "Hashing.hpp"
+
+
+namespace
+{
+    bool isLetter(char c)
+    {
+        return c >= 'A' && c <= 'Z';
+    }
+
+
+    std::uint64_t hashOf(std::string_view s)
+    {
+        return hashing::hashBytes(s.data(), s.size());
+    }
+
+
+    // hashWithout() returns the hash of s with the character at index i
+    // deleted, using the given buffer to build it.
+    std::uint64_t hashWithout(std::string_view s, std::size_t i, std::string& buffer)
+    {
+        buffer.assign(s.data(), i);
+        buffer.append(s.data() + i + 1, s.size() - i - 1);
+        return hashOf(buffer);
+    }
+
+
+    // isSuggestion() returns true if WordChecker would suggest candidate
+    // for query: it's one adjacent swap, one insertion of a letter, one
+    // deletion, or one replacement with a letter away from the query.
+    // (Note that the query itself is a suggestion if it's a word, since
+    // replacing a letter with itself is a replacement.)
+    bool isSuggestion(std::string_view query, std::string_view candidate)
+    {
+        std::size_t first = 0;
+
+        while (first < query.size() && first < candidate.size()
+               && query[first] == candidate[first])
+        {
+            ++first;
+        }
+
+        if (candidate.size() == query.size() + 1)
+        {
+            return isLetter(candidate[first])
+                && candidate.substr(first + 1) == query.substr(first);
+        }
+        else if (candidate.size() + 1 == query.size())
+        {
+            return candidate.substr(first) == query.substr(first + 1);
+        }
+        else if (candidate.size() != query.size())
+        {
+            return false;
+        }
+        else if (first == query.size())
+        {
+            // The candidate is the query.  Replacing a letter with itself
+            // finds it, as does swapping two equal adjacent characters.
+            for (std::size_t i = 0; i < query.size(); ++i)
+            {
+                if (isLetter(query[i]) || (i + 1 < query.size() && query[i] == query[i + 1]))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+        else if (candidate.substr(first + 1) == query.substr(first + 1))
+        {
+            return isLetter(candidate[first]);
+        }
+        else
+        {
+            return first + 1 < query.size()
+                && candidate[first] == query[first + 1]
+                && candidate[first + 1] == query[first]
+                && candidate.substr(first + 2) == query.substr(first + 2);
+        }
+    }
+}
+
+
+DeletionIndex::DeletionIndex(const std::vector<std::string>& words)
+{
+    std::vector<std::string_view> sorted{words.begin(), words.end()};
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::size_t totalLength = 0;
+
+    for (std::string_view w : sorted)
+    {
+        totalLength += w.size();
+    }
+
+    characters.reserve(totalLength);
+    wordOffsets.reserve(sorted.size() + 1);
+    wordOffsets.push_back(0);
+
+    for (std::string_view w : sorted)
+    {
+        characters.insert(characters.end(), w.begin(), w.end());
+        wordOffsets.push_back(static_cast<std::uint32_t>(characters.size()));
+    }
+
+    // Gather a (key hash, word) pair for each word and each distinct
+    // deletion of it, then sort them so that each key's words are
+    // together.
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> entries;
+    entries.reserve(totalLength + sorted.size());
+    std::string buffer;
+
+    for (std::uint32_t id = 0; id < sorted.size(); ++id)
+    {
+        std::string_view w = word(id);
+        entries.emplace_back(hashOf(w), id);
+
+        for (std::size_t i = 0; i < w.size(); ++i)
+        {
+            // Deleting any character in a run of equal characters gives
+            // the same result, so only the first in each run is used.
+            if (i == 0 || w[i] != w[i - 1])
+            {
+                entries.emplace_back(hashWithout(w, i, buffer), id);
+            }
+        }
+    }
+
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+
+    postings.reserve(entries.size());
+
+    for (std::size_t i = 0; i < entries.size(); ++i)
+    {
+        if (i == 0 || entries[i].first != entries[i - 1].first)
+        {
+            keyHashes.push_back(entries[i].first);
+            keyOffsets.push_back(static_cast<std::uint32_t>(postings.size()));
+        }
+
+        postings.push_back(entries[i].second);
+    }
+
+    keyOffsets.push_back(static_cast<std::uint32_t>(postings.size()));
+    keyHashes.shrink_to_fit();
+    keyOffsets.shrink_to_fit();
+
+    // The table is kept at most two-thirds full.
+    std::size_t tableSize = 16;
+
+    while (tableSize * 2 < keyHashes.size() * 3)
+    {
+        tableSize *= 2;
+    }
+
+    table.assign(tableSize, 0);
+
+    for (std::uint32_t k = 0; k < keyHashes.size(); ++k)
+    {
+        std::size_t slot = keyHashes[k] & (tableSize - 1);
+
+        while (table[slot] != 0)
+        {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        table[slot] = k + 1;
+    }
+}
+
+
+bool DeletionIndex::wordExists(std::string_view w) const
+{
+    std::uint32_t begin;
+    std::uint32_t end;
+
+    if (findKey(hashOf(w), begin, end))
+    {
+        for (std::uint32_t i = begin; i < end; ++i)
+        {
+            if (word(postings[i]) == w)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+
+std::vector<std::string> DeletionIndex::findSuggestions(const std::string& query) const
+{
+    std::vector<std::uint32_t> found;
+    std::string buffer;
+
+    auto consider = [&](std::uint64_t hash)
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+
+        if (findKey(hash, begin, end))
+        {
+            for (std::uint32_t i = begin; i < end; ++i)
+            {
+                if (isSuggestion(query, word(postings[i])))
+                {
+                    found.push_back(postings[i]);
+                }
+            }
+        }
+    };
+
+    consider(hashOf(query));
+
+    for (std::size_t i = 0; i < query.size(); ++i)
+    {
+        if (i == 0 || query[i] != query[i - 1])
+        {
+            consider(hashWithout(query, i, buffer));
+        }
+    }
+
+    // Words are numbered alphabetically, so sorting the numbers sorts the
+    // words.
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    std::vector<std::string> suggestions;
+    suggestions.reserve(found.size());
+
+    for (std::uint32_t id : found)
+    {
+        suggestions.emplace_back(word(id));
+    }
+
+    // Splitting the word into two words is the one kind of suggestion
+    // that isn't a single edit; it's found by looking up both halves.
+    std::string_view whole = query;
+    bool split = false;
+
+    for (std::size_t m = 0; m + 1 < query.size(); ++m)
+    {
+        if (wordExists(whole.substr(0, m)) && wordExists(whole.substr(m)))
+        {
+            suggestions.push_back(query.substr(0, m) + " " + query.substr(m));
+            split = true;
+        }
+    }
+
+    if (split)
+    {
+        std::sort(suggestions.begin(), suggestions.end());
+        suggestions.erase(std::unique(suggestions.begin(), suggestions.end()), suggestions.end());
+    }
+
+    return suggestions;
+}
+
+
+unsigned int DeletionIndex::size() const noexcept
+{
+    return static_cast<unsigned int>(wordOffsets.size() - 1);
+}
+
+
+std::size_t DeletionIndex::memoryUsage() const noexcept
+{
+    return characters.capacity() * sizeof(char)
+        + wordOffsets.capacity() * sizeof(std::uint32_t)
+        + keyHashes.capacity() * sizeof(std::uint64_t)
+        + keyOffsets.capacity() * sizeof(std::uint32_t)
+        + postings.capacity() * sizeof(std::uint32_t)
+        + table.capacity() * sizeof(std::uint32_t);
+}
+
+
+std::string_view DeletionIndex::word(std::uint32_t id) const noexcept
+{
+    return std::string_view{
+        characters.data() + wordOffsets[id], wordOffsets[id + 1] - wordOffsets[id]};
+}
+
+
+bool DeletionIndex::findKey(std::uint64_t hash, std::uint32_t& begin, std::uint32_t& end) const noexcept
+{
+    std::size_t mask = table.size() - 1;
+
+    for (std::size_t slot = hash & mask; table[slot] != 0; slot = (slot + 1) & mask)
+    {
+        std::uint32_t k = table[slot] - 1;
+
+        if (keyHashes[k] == hash)
+        {
+            begin = keyOffsets[k];
+            end = keyOffsets[k + 1];
+            return true;
+        }
+    }
+
+    return false;
+}
+
@@ -0,0 +1,88 @@
+// DeletionIndex.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DeletionIndex is an alternative to WordChecker::findSuggestions() for
+// a dictionary that doesn't change once it's been built.  Rather than
+// generating every possible edit of a misspelled word (roughly 54 of them
+// per letter) and looking each one up, it does the expensive part ahead of
+// time: every word in the dictionary is indexed under itself and under
+// each of the words that can be made by deleting one of its characters.
+//
+// Two words that are one edit apart always share one of those keys: an
+// insertion or deletion turns one word into a key of the other, and a
+// replacement or a swap of adjacent characters leaves the two words with
+// a deletion in common.  So a query only needs to look up the word itself
+// and its own n deletions, and then check which of the words found there
+// really are one of the five kinds of edit that WordChecker looks for.
+// The result is the same set of suggestions that WordChecker would find
+// with the same words in its Set, though they're returned in
+// alphabetical order rather than in the order WordChecker finds them.
+//
+// (This is the idea behind the "symmetric delete" algorithm, SymSpell.)
+
+#ifndef DELETIONINDEX_HPP
+#define DELETIONINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+
+class DeletionIndex
+{
+public:
+    // Builds an index of the given words.  Duplicates are ignored.
+    explicit DeletionIndex(const std::vector<std::string>& words);
+
+
+    // wordExists() returns true if the given word is in the index, false
+    // otherwise.
+    bool wordExists(std::string_view word) const;
+
+
+    // findSuggestions() returns the same suggestions that the five
+    // algorithms in WordChecker::findSuggestions() would, in alphabetical
+    // order.
+    std::vector<std::string> findSuggestions(const std::string& word) const;
+
+
+    // size() returns the number of distinct words in the index.
+    unsigned int size() const noexcept;
+
+
+    // memoryUsage() returns the approximate number of bytes used by the
+    // index, not counting the DeletionIndex object itself.
+    std::size_t memoryUsage() const noexcept;
+
+
+private:
+    // The words are stored back-to-back in one array of characters, in
+    // alphabetical order; word i is the characters in the range
+    // [wordOffsets[i], wordOffsets[i + 1]).
+    std::vector<char> characters;
+    std::vector<std::uint32_t> wordOffsets;
+
+    // Each distinct key (i.e., a word or a deletion of one) is known only
+    // by its 64-bit hash.  The words filed under key k are the ones listed
+    // in postings[keyOffsets[k]] through postings[keyOffsets[k + 1] - 1].
+    // The keys are found using an open-addressed table of key numbers
+    // (plus one, so that 0 can mean an empty slot).  Hashes can collide,
+    // so the words found under a key are always checked against the query.
+    std::vector<std::uint64_t> keyHashes;
+    std::vector<std::uint32_t> keyOffsets;
+    std::vector<std::uint32_t> postings;
+    std::vector<std::uint32_t> table;
+
+    std::string_view word(std::uint32_t id) const noexcept;
+    bool findKey(std::uint64_t hash, std::uint32_t& begin, std::uint32_t& end) const noexcept;
+};
+
+
+
+#endif // DELETIONINDEX_HPP
+
@@ -0,0 +1,105 @@
+// DeletionIndex_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DeletionIndex, mostly checking that it finds exactly the
+// suggestions that WordChecker does.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DeletionIndex.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::vector<std::string> sorted(std::vector<std::string> v)
+    {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+
+    std::string randomWord(std::mt19937& engine, unsigned int maxLength, char lastLetter)
+    {
+        std::uniform_int_distribution<unsigned int> length{0, maxLength};
+        std::uniform_int_distribution<int> letter{'A', lastLetter};
+        std::string word(length(engine), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(letter(engine));
+        }
+
+        return word;
+    }
+}
+
+
+TEST(DeletionIndex_Tests, containsExactlyTheGivenWords)
+{
+    DeletionIndex index{{"CAT", "DOG", "CAT", "A"}};
+
+    EXPECT_EQ(3, index.size());
+    EXPECT_TRUE(index.wordExists("CAT"));
+    EXPECT_TRUE(index.wordExists("DOG"));
+    EXPECT_TRUE(index.wordExists("A"));
+    EXPECT_FALSE(index.wordExists("CA"));
+    EXPECT_FALSE(index.wordExists("AT"));
+    EXPECT_FALSE(index.wordExists(""));
+}
+
+
+TEST(DeletionIndex_Tests, findsEachKindOfSuggestion)
+{
+    DeletionIndex index{{"ACT", "CART", "AT", "BAT", "CAT", "THE", "THECAT", "CTA"}};
+
+    std::vector<std::string> expected{"ACT", "AT", "BAT", "CART", "CAT", "CTA"};
+    EXPECT_EQ(expected, index.findSuggestions("CAT"));
+
+    std::vector<std::string> split{"THE CAT", "THECAT"};
+    EXPECT_EQ(split, index.findSuggestions("THECAT"));
+}
+
+
+TEST(DeletionIndex_Tests, agreesWithWordChecker)
+{
+    // A small alphabet and short words make for dense neighbourhoods, with
+    // plenty of repeated letters, swaps and splits.
+    std::mt19937 engine{46};
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        words.push_back(randomWord(engine, 6, 'E'));
+    }
+
+    words.push_back("A1B");
+    words.push_back("AB");
+
+    HashSet<std::string> set;
+
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+    DeletionIndex index{words};
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::string query = randomWord(engine, 7, 'F');
+        EXPECT_EQ(sorted(checker.findSuggestions(query)), index.findSuggestions(query)) << query;
+    }
+
+    for (std::string query : {"A1B", "AB", "1AB", "A11B", "1", "11"})
+    {
+        EXPECT_EQ(sorted(checker.findSuggestions(query)), index.findSuggestions(query)) << query;
+    }
+}
@@ -0,0 +1,109 @@
+// DocumentChecker.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "DocumentChecker.hpp"
+
+
+namespace
+{
+    bool isLetter(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    }
+
+
+    char toUpper(char c) noexcept
+    {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+}
+
+
+DocumentChecker::DocumentChecker(const WordChecker& checker, unsigned int threadCount)
+    : checker{checker}, pool{threadCount}
+{
+}
+
+
+std::vector<DocumentChecker::CheckedWord> DocumentChecker::checkDocument(std::string_view text)
+{
+    std::vector<CheckedWord> words = tokenize(text);
+    check(words);
+    return words;
+}
+
+
+std::vector<DocumentChecker::CheckedWord> DocumentChecker::checkWords(const std::vector<std::string>& words)
+{
+    std::vector<CheckedWord> checked;
+    checked.reserve(words.size());
+
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        checked.push_back(CheckedWord{words[i], i, false, {}});
+    }
+
+    check(checked);
+    return checked;
+}
+
+
+unsigned int DocumentChecker::threadCount() const noexcept
+{
+    return pool.threadCount();
+}
+
+
+std::vector<DocumentChecker::CheckedWord> DocumentChecker::tokenize(std::string_view text)
+{
+    std::vector<CheckedWord> words;
+    std::size_t i = 0;
+
+    while (i < text.size())
+    {
+        if (!isLetter(text[i]))
+        {
+            ++i;
+            continue;
+        }
+
+        std::size_t start = i;
+        std::string word;
+
+        for (; i < text.size() && isLetter(text[i]); ++i)
+        {
+            word.push_back(toUpper(text[i]));
+        }
+
+        words.push_back(CheckedWord{std::move(word), start, false, {}});
+    }
+
+    return words;
+}
+
+
+void DocumentChecker::check(std::vector<CheckedWord>& words)
+{
+    std::size_t chunkCount = (words.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    pool.run(chunkCount, [&](std::size_t chunk)
+    {
+        std::size_t first = chunk * CHUNK_SIZE;
+        std::size_t last = std::min(first + CHUNK_SIZE, words.size());
+
+        for (std::size_t i = first; i < last; ++i)
+        {
+            CheckedWord& word = words[i];
+            word.exists = checker.wordExists(word.word);
+
+            if (!word.exists)
+            {
+                word.suggestions = checker.findSuggestions(word.word);
+            }
+        }
+    });
+}
@@ -0,0 +1,107 @@
+// DocumentChecker.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A DocumentChecker checks the spelling of a whole document (or a list of
+// words) at once, using a WordChecker, by splitting the words into chunks
+// and running one task per chunk on a WorkStealingPool.  Each task looks
+// up the words in its chunk with wordExists(), and calls findSuggestions()
+// for the ones that are misspelled, writing the results into the slots
+// reserved for those words; so the results come back in the same order
+// as the words, no matter which thread checked which.
+//
+// The pool's threads are started when the DocumentChecker is created and
+// wait between batches, so checking a small document doesn't pay for
+// starting threads.  The thread that asks for a batch to be checked works
+// on it too, so a DocumentChecker with a thread count of 1 starts no
+// threads.
+//
+// Every thread searches the same Set, without any locking, so the Set
+// must be safe to search from several threads at once.  Every Set in this
+// project is, as long as nothing is being added to it -- except a HashSet
+// that's partway through an incremental resize, since its contains()
+// moves some of the resize along; call finishResizing() on it first.
+//
+// A document is split into words at every character that isn't a letter,
+// and the words are converted to uppercase, matching the dictionary.
+
+#ifndef DOCUMENTCHECKER_HPP
+#define DOCUMENTCHECKER_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "WordChecker.hpp"
+#include "WorkStealingPool.hpp"
+
+
+
+class DocumentChecker
+{
+public:
+    // A CheckedWord is the result of checking one word: the word itself
+    // (in uppercase), where it began in the document (or its index in a
+    // list of words), whether it's spelled correctly, and, if not, the
+    // suggestions for it.
+    struct CheckedWord
+    {
+        std::string word;
+        std::size_t position;
+        bool exists;
+        std::vector<std::string> suggestions;
+    };
+
+
+public:
+    // Initializes a DocumentChecker that checks words with the given
+    // WordChecker, using the given number of threads (including the one
+    // that asks for each batch to be checked).  A thread count of 0 is
+    // treated as 1.
+    explicit DocumentChecker(
+        const WordChecker& checker,
+        unsigned int threadCount = std::thread::hardware_concurrency());
+
+    DocumentChecker(const DocumentChecker&) = delete;
+    DocumentChecker& operator=(const DocumentChecker&) = delete;
+
+
+    // checkDocument() splits the given text into words and checks each
+    // one, returning the results in the order the words appear.
+    std::vector<CheckedWord> checkDocument(std::string_view text);
+
+
+    // checkWords() checks each of the given words, exactly as given,
+    // returning the results in the same order.
+    std::vector<CheckedWord> checkWords(const std::vector<std::string>& words);
+
+
+    // threadCount() returns the number of threads that check words,
+    // including the one that asks for each batch to be checked.
+    unsigned int threadCount() const noexcept;
+
+
+    // tokenize() splits the given text into its words, as checkDocument()
+    // does, with each word's position in the text.
+    static std::vector<CheckedWord> tokenize(std::string_view text);
+
+
+private:
+    // The number of words in each of the pool's tasks.  Chunks are large
+    // enough that the cost of taking a task is spread over many words,
+    // but small enough that a chunk full of misspelled words (which take
+    // far longer to check) doesn't leave the other threads idle at the
+    // end of a batch.
+    static constexpr std::size_t CHUNK_SIZE = 64;
+
+    const WordChecker& checker;
+    WorkStealingPool pool;
+
+    void check(std::vector<CheckedWord>& words);
+};
+
+
+
+#endif // DOCUMENTCHECKER_HPP
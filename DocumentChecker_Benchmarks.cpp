@@ -0,0 +1,92 @@
+// DocumentChecker_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks for DocumentChecker.
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Benchmark.hpp"
+#include "DocumentChecker.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // makeCorpus() returns a document of the given number of words, drawn
+    // from the dictionary and written in lowercase with punctuation between
+    // them, with one word in "missRate" misspelled by replacing a letter.
+    std::string makeCorpus(
+        const std::vector<std::string>& words, unsigned int length,
+        unsigned int missRate, unsigned int seed)
+    {
+        static const char* const separators[] = {" ", " ", " ", ", ", ". ", "\n", "; "};
+
+        std::mt19937 engine{seed};
+        std::string corpus;
+
+        for (unsigned int i = 0; i < length; ++i)
+        {
+            std::string word = words[engine() % words.size()];
+
+            if (engine() % missRate == 0)
+            {
+                word[engine() % word.size()] = static_cast<char>('A' + engine() % 26);
+            }
+
+            for (char c : word)
+            {
+                corpus.push_back(static_cast<char>(c - 'A' + 'a'));
+            }
+
+            corpus += separators[engine() % 7];
+        }
+
+        return corpus;
+    }
+}
+
+
+BENCHMARK(DocumentChecker, threadScaling)
+{
+    std::vector<std::string> words = bench::makeWords(200000, 41);
+    HashSet<std::string> set;
+
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+    std::string corpus = makeCorpus(words, 500000, 20, 42);
+    std::size_t tokens = DocumentChecker::tokenize(corpus).size();
+
+    std::printf("  %.1f MB corpus, %zu words, %u hardware threads\n",
+        corpus.size() / 1048576.0, tokens, std::thread::hardware_concurrency());
+
+    for (unsigned int threads : {1u, 2u, 4u, 8u, 16u, 32u})
+    {
+        DocumentChecker documents{checker, threads};
+        bench::Stopwatch watch;
+
+        std::vector<DocumentChecker::CheckedWord> checked = documents.checkDocument(corpus);
+
+        double ms = watch.elapsedMilliseconds();
+        std::size_t misses = 0;
+
+        for (const DocumentChecker::CheckedWord& word : checked)
+        {
+            misses += word.exists ? 0 : 1;
+        }
+
+        bench::doNotOptimize(misses);
+
+        std::printf("    %2u threads  %8.1f ms  %6.2fM words/s  (%zu misspelled)\n",
+            threads, ms, checked.size() / ms / 1000.0, misses);
+    }
+}
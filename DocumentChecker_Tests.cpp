@@ -0,0 +1,199 @@
+// DocumentChecker_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for DocumentChecker.
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "DocumentChecker.hpp"
+#include "HashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    const std::vector<std::string> DICTIONARY{
+        "CAT", "CART", "CAST", "COAT", "CUT", "AT", "ACT", "SCAT",
+        "BAT", "HAT", "THE", "CATS", "TAC", "A", "THECAT", "APPLE"};
+
+
+    HashSet<std::string> makeDictionary()
+    {
+        HashSet<std::string> words;
+
+        for (const std::string& word : DICTIONARY)
+        {
+            words.add(word);
+        }
+
+        return words;
+    }
+
+
+    // A Set that throws when asked about one particular word, to check
+    // that a failure on one thread reaches the caller.
+    class ThrowingSet : public Set<std::string>
+    {
+    public:
+        virtual bool isImplemented() const noexcept override { return true; }
+        virtual void add(const std::string&) override { }
+        virtual unsigned int size() const noexcept override { return 0; }
+
+        virtual bool contains(const std::string& element) const override
+        {
+            if (element == "BOOM")
+            {
+                throw std::runtime_error{"BOOM"};
+            }
+
+            return true;
+        }
+    };
+}
+
+
+TEST(DocumentChecker_Tests, tokenizeSplitsAtNonLettersAndUppercases)
+{
+    std::vector<DocumentChecker::CheckedWord> words =
+        DocumentChecker::tokenize("  The cat's HAT, 42x-ray\n\tok");
+
+    std::vector<std::string> expected{"THE", "CAT", "S", "HAT", "X", "RAY", "OK"};
+    std::vector<std::size_t> positions{2, 6, 10, 12, 19, 21, 26};
+
+    ASSERT_EQ(expected.size(), words.size());
+
+    for (std::size_t i = 0; i < words.size(); ++i)
+    {
+        EXPECT_EQ(expected[i], words[i].word);
+        EXPECT_EQ(positions[i], words[i].position);
+    }
+
+    EXPECT_TRUE(DocumentChecker::tokenize("").empty());
+    EXPECT_TRUE(DocumentChecker::tokenize(" 12, -- !").empty());
+}
+
+
+TEST(DocumentChecker_Tests, suggestsOnlyForMisspelledWords)
+{
+    HashSet<std::string> words = makeDictionary();
+    WordChecker checker{words};
+    DocumentChecker documents{checker, 2};
+
+    std::vector<DocumentChecker::CheckedWord> checked = documents.checkDocument("The caat sat on a hat.");
+
+    ASSERT_EQ(6, checked.size());
+    EXPECT_EQ((std::vector<bool>{true, false, false, false, true, true}),
+        (std::vector<bool>{checked[0].exists, checked[1].exists, checked[2].exists,
+            checked[3].exists, checked[4].exists, checked[5].exists}));
+
+    for (const DocumentChecker::CheckedWord& word : checked)
+    {
+        EXPECT_EQ(word.exists ? std::vector<std::string>{} : checker.findSuggestions(word.word),
+            word.suggestions) << word.word;
+    }
+
+    EXPECT_FALSE(checked[1].suggestions.empty());
+}
+
+
+TEST(DocumentChecker_Tests, resultsAreInInputOrderWhateverTheThreadCount)
+{
+    HashSet<std::string> words = makeDictionary();
+    WordChecker checker{words};
+    std::vector<std::string> input;
+
+    // Enough words that every thread takes several chunks.
+    for (unsigned int i = 0; i < 5000; ++i)
+    {
+        const std::string& word = DICTIONARY[(i * 7) % DICTIONARY.size()];
+        input.push_back(i % 3 == 0 ? word + "X" : word);
+    }
+
+    DocumentChecker single{checker, 1};
+    std::vector<DocumentChecker::CheckedWord> expected = single.checkWords(input);
+
+    EXPECT_EQ(1, single.threadCount());
+    ASSERT_EQ(input.size(), expected.size());
+
+    for (unsigned int threads : {2u, 4u, 8u})
+    {
+        DocumentChecker documents{checker, threads};
+        EXPECT_EQ(threads, documents.threadCount());
+
+        // The same DocumentChecker can check one batch after another.
+        for (unsigned int round = 0; round < 3; ++round)
+        {
+            std::vector<DocumentChecker::CheckedWord> checked = documents.checkWords(input);
+            ASSERT_EQ(expected.size(), checked.size());
+
+            for (std::size_t i = 0; i < checked.size(); ++i)
+            {
+                EXPECT_EQ(input[i], checked[i].word);
+                EXPECT_EQ(i, checked[i].position);
+                EXPECT_EQ(i % 3 != 0, checked[i].exists) << i;
+                EXPECT_EQ(expected[i].suggestions, checked[i].suggestions) << i;
+            }
+        }
+    }
+}
+
+
+TEST(DocumentChecker_Tests, checksAnIncrementallyResizedHashSetOnceFinished)
+{
+    HashSet<std::string> words{DefaultHash<std::string>{}, true};
+
+    for (unsigned int i = 0; i < 3000; ++i)
+    {
+        words.add("WORD" + std::to_string(i));
+    }
+
+    words.finishResizing();
+
+    WordChecker checker{words};
+    DocumentChecker documents{checker, 4};
+    std::string text;
+
+    for (unsigned int i = 0; i < 6000; ++i)
+    {
+        text += "word" + std::string(1, static_cast<char>('a' + i % 26)) + " ";
+    }
+
+    for (const DocumentChecker::CheckedWord& word : documents.checkDocument(text))
+    {
+        EXPECT_FALSE(word.exists);
+    }
+
+    EXPECT_FALSE(words.isResizing());
+}
+
+
+TEST(DocumentChecker_Tests, emptyInputGivesNoResults)
+{
+    HashSet<std::string> words = makeDictionary();
+    WordChecker checker{words};
+    DocumentChecker documents{checker, 3};
+
+    EXPECT_TRUE(documents.checkDocument("").empty());
+    EXPECT_TRUE(documents.checkDocument("...!").empty());
+    EXPECT_TRUE(documents.checkWords({}).empty());
+}
+
+
+TEST(DocumentChecker_Tests, exceptionsReachTheCaller)
+{
+    ThrowingSet words;
+    WordChecker checker{words};
+    DocumentChecker documents{checker, 4};
+    std::vector<std::string> input(1000, "FINE");
+    input[777] = "BOOM";
+
+    EXPECT_THROW(documents.checkWords(input), std::runtime_error);
+
+    // The threads are still there for the next batch.
+    input[777] = "FINE";
+    EXPECT_EQ(1000, documents.checkWords(input).size());
+}
@@ -0,0 +1,521 @@
+// FlatHashSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FlatHashSet is an implementation of a Set that is an open-addressed
+// hash table in the style of a "Swiss table."  Rather than giving each
+// element its own dynamically-allocated node, as HashSet does, the
+// elements are stored directly in one flat array of slots.  Alongside it
+// is an array of one-byte "control" values, one per slot, which is either
+// EMPTY or holds seven bits of the element's hash.
+//
+// The slots are divided into groups of GROUP_WIDTH (16) consecutive slots.
+// A lookup hashes the element once, uses part of the hash to choose the
+// first group to probe, and then compares the remaining seven bits against
+// all sixteen control bytes of the group at once (using SSE2 when it's
+// available).  Only the slots whose control byte matches are compared
+// against the element itself, so most lookups that fail never touch a key
+// at all, and most that succeed touch exactly one.  If the group has no
+// EMPTY slots and no match, the next group is probed.
+//
+// As elements are added and the proportion of the FlatHashSet's size to
+// its capacity would exceed 7/8, the array of slots is resized so that
+// it is twice as large as it was before.  The capacity is always a power
+// of two and a multiple of GROUP_WIDTH.
+
+#ifndef FLATHASHSET_HPP
+#define FLATHASHSET_HPP
+
+#include <cstdint>
+#include <functional>
+#include <new>
+#include <utility>
+#include <vector>
+#include "Set.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+
+template <typename ElementType>
+class FlatHashSet : public Set<ElementType>
+{
+public:
+    // The default capacity of the FlatHashSet before anything has been
+    // added to it.
+    static constexpr unsigned int DEFAULT_CAPACITY = 16;
+
+    // The number of slots whose control bytes are examined together.
+    static constexpr unsigned int GROUP_WIDTH = 16;
+
+    // A HashFunction is a function that takes a reference to a const
+    // ElementType and returns an unsigned int.
+    using HashFunction = std::function<unsigned int(const ElementType&)>;
+
+public:
+    // Initializes a FlatHashSet to be empty, so that it will use the given
+    // hash function whenever it needs to hash an element.
+    explicit FlatHashSet(HashFunction hashFunction);
+
+    // Cleans up the FlatHashSet so that it leaks no memory.
+    virtual ~FlatHashSet() noexcept;
+
+    // Initializes a new FlatHashSet to be a copy of an existing one.
+    FlatHashSet(const FlatHashSet& s);
+
+    // Initializes a new FlatHashSet whose contents are moved from an
+    // expiring one.
+    FlatHashSet(FlatHashSet&& s) noexcept;
+
+    // Assigns an existing FlatHashSet into another.
+    FlatHashSet& operator=(const FlatHashSet& s);
+
+    // Assigns an expiring FlatHashSet into another.
+    FlatHashSet& operator=(FlatHashSet&& s) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  This function triggers a resizing
+    // of the slot array when the ratio of size to capacity would exceed
+    // 7/8, in which case it runs in linear time; otherwise, it runs in
+    // constant time (assuming a good hash function).
+    virtual void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function runs in constant time (assuming a
+    // good hash function).
+    virtual bool contains(const ElementType& element) const override;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const noexcept override;
+
+
+    // capacity() returns the number of slots in the slot array.
+    unsigned int capacity() const noexcept;
+
+
+private:
+    // A control byte is EMPTY if its slot is unoccupied; otherwise, it
+    // holds the low seven bits of the occupant's hash, so it is never
+    // negative.  Elements are never removed, so there are no tombstones.
+    static constexpr std::int8_t EMPTY = -128;
+
+    HashFunction hashFunction;
+    std::int8_t* control;
+    ElementType* slots;
+    unsigned int total_capacity;
+    unsigned int total_size;
+
+    FlatHashSet(HashFunction hashFunction, unsigned int capacity);
+
+    static unsigned int mix(unsigned int hash) noexcept;
+    static std::uint32_t match_byte(const std::int8_t* group, std::int8_t value) noexcept;
+
+    void allocate(unsigned int capacity);
+    void destroy() noexcept;
+    void copy_from(const FlatHashSet& s);
+    unsigned int probe(const ElementType& element, unsigned int hash, bool& found) const;
+    template <typename Element>
+    void place(unsigned int index, Element&& element, unsigned int hash);
+    template <typename Element>
+    void insert_unique(Element&& element, unsigned int hash);
+    void grow();
+};
+
+
+
+///--------------------------------------Helper Function---------------------------------------
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::mix(unsigned int hash) noexcept
+{
+    // The caller's hash function may leave the high or low bits poorly
+    // distributed (e.g., the identity function on integers), but we use
+    // both ends of the hash for different purposes, so we spread them
+    // out first.  This is MurmurHash3's 32-bit finalizer.
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6bu;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+
+template <typename ElementType>
+std::uint32_t FlatHashSet<ElementType>::match_byte(const std::int8_t* group, std::int8_t value) noexcept
+{
+    // Returns a bit mask with bit i set if the i-th control byte in the
+    // group is equal to the given value.
+#if defined(__SSE2__)
+    __m128i bytes = _mm_load_si128(reinterpret_cast<const __m128i*>(group));
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value))));
+#else
+    std::uint32_t mask = 0;
+
+    for (unsigned int i = 0; i < GROUP_WIDTH; ++i)
+    {
+        mask |= static_cast<std::uint32_t>(group[i] == value) << i;
+    }
+
+    return mask;
+#endif
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::allocate(unsigned int capacity)
+{
+    // The control bytes are aligned to GROUP_WIDTH so that each group can
+    // be loaded with a single aligned load.  Neither array is stored until
+    // both have been allocated, so a failure leaves the set unchanged.
+    std::int8_t* new_control = static_cast<std::int8_t*>(
+        ::operator new(capacity, std::align_val_t{GROUP_WIDTH}));
+    ElementType* new_slots;
+
+    try
+    {
+        new_slots = static_cast<ElementType*>(::operator new(sizeof(ElementType) * capacity));
+    }
+    catch (...)
+    {
+        ::operator delete(new_control, std::align_val_t{GROUP_WIDTH});
+        throw;
+    }
+
+    for (unsigned int i = 0; i < capacity; ++i)
+    {
+        new_control[i] = EMPTY;
+    }
+
+    control = new_control;
+    slots = new_slots;
+    total_capacity = capacity;
+    total_size = 0;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::destroy() noexcept
+{
+    if (control == nullptr)
+    {
+        return;
+    }
+
+    for (unsigned int i = 0; i < total_capacity; ++i)
+    {
+        if (control[i] != EMPTY)
+        {
+            slots[i].~ElementType();
+        }
+    }
+
+    ::operator delete(slots);
+    ::operator delete(control, std::align_val_t{GROUP_WIDTH});
+    control = nullptr;
+    slots = nullptr;
+    total_capacity = 0;
+    total_size = 0;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::copy_from(const FlatHashSet& s)
+{
+    // A moved-from set has no arrays at all, so its copy starts out empty
+    // at the default capacity, just as a newly-constructed one would.
+    if (s.control == nullptr)
+    {
+        allocate(DEFAULT_CAPACITY);
+        return;
+    }
+
+    allocate(s.total_capacity);
+
+    try
+    {
+        // The copy has the same capacity and hash function, so every
+        // element can be copied into the same slot it occupies in s.
+        for (unsigned int i = 0; i < total_capacity; ++i)
+        {
+            if (s.control[i] != EMPTY)
+            {
+                new (&slots[i]) ElementType{s.slots[i]};
+                control[i] = s.control[i];
+                total_size++;
+            }
+        }
+    }
+    catch (...)
+    {
+        destroy();
+        throw;
+    }
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::probe(const ElementType& element, unsigned int hash, bool& found) const
+{
+    // Searches for an element, given its mixed hash.  If it's found, sets
+    // "found" and returns the index of its slot; otherwise, returns the
+    // index of the first empty slot along its probe sequence, which is
+    // where it belongs.  The groups are probed in triangular order (1, 2,
+    // 3, ... groups apart), which visits every group when the number of
+    // groups is a power of two.
+    std::int8_t tag = static_cast<std::int8_t>(hash & 0x7f);
+    unsigned int groupMask = total_capacity / GROUP_WIDTH - 1;
+    unsigned int group = (hash >> 7) & groupMask;
+
+    for (unsigned int step = 1; ; ++step)
+    {
+        const std::int8_t* groupControl = control + group * GROUP_WIDTH;
+
+        for (std::uint32_t candidates = match_byte(groupControl, tag);
+             candidates != 0; candidates &= candidates - 1)
+        {
+            unsigned int index = group * GROUP_WIDTH + __builtin_ctz(candidates);
+
+            if (slots[index] == element)
+            {
+                found = true;
+                return index;
+            }
+        }
+
+        // An element is always placed in the first group along its probe
+        // sequence that has an empty slot, so if this group has one, the
+        // element can't be any further along.
+        if (std::uint32_t empty = match_byte(groupControl, EMPTY))
+        {
+            found = false;
+            return group * GROUP_WIDTH + __builtin_ctz(empty);
+        }
+
+        group = (group + step) & groupMask;
+    }
+}
+
+
+template <typename ElementType>
+template <typename Element>
+void FlatHashSet<ElementType>::place(unsigned int index, Element&& element, unsigned int hash)
+{
+    new (&slots[index]) ElementType{std::forward<Element>(element)};
+    control[index] = static_cast<std::int8_t>(hash & 0x7f);
+    total_size++;
+}
+
+
+template <typename ElementType>
+template <typename Element>
+void FlatHashSet<ElementType>::insert_unique(Element&& element, unsigned int hash)
+{
+    // Inserts an element known not to be in the set, given its mixed hash,
+    // into the first empty slot along its probe sequence, without comparing
+    // it to anything.
+    unsigned int groupMask = total_capacity / GROUP_WIDTH - 1;
+    unsigned int group = (hash >> 7) & groupMask;
+
+    for (unsigned int step = 1; ; ++step)
+    {
+        std::int8_t* groupControl = control + group * GROUP_WIDTH;
+        std::uint32_t empty = match_byte(groupControl, EMPTY);
+
+        if (empty != 0)
+        {
+            place(group * GROUP_WIDTH + __builtin_ctz(empty), std::forward<Element>(element), hash);
+            return;
+        }
+
+        group = (group + step) & groupMask;
+    }
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::grow()
+{
+    // The elements are moved into a new, larger set, which only replaces
+    // this one once all of them are in it.  Every element is hashed before
+    // any is moved, and elements whose move constructor might throw are
+    // copied instead, so if anything throws along the way, the new set is
+    // destroyed and this one is unchanged.
+    FlatHashSet grown{hashFunction, total_capacity * 2};
+    std::vector<unsigned int> hashes;
+    hashes.reserve(total_size);
+
+    for (unsigned int i = 0; i < total_capacity; ++i)
+    {
+        if (control[i] != EMPTY)
+        {
+            hashes.push_back(mix(hashFunction(slots[i])));
+        }
+    }
+
+    auto hash = hashes.begin();
+
+    for (unsigned int i = 0; i < total_capacity; ++i)
+    {
+        if (control[i] != EMPTY)
+        {
+            grown.insert_unique(std::move_if_noexcept(slots[i]), *hash++);
+        }
+    }
+
+    *this = std::move(grown);
+}
+///--------------------------------------------------------------------------------------------
+
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(HashFunction hashFunction)
+    : FlatHashSet{hashFunction, DEFAULT_CAPACITY}
+{
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(HashFunction hashFunction, unsigned int capacity)
+    : hashFunction{hashFunction}, control{nullptr}, slots{nullptr},
+      total_capacity{0}, total_size{0}
+{
+    allocate(capacity);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::~FlatHashSet() noexcept
+{
+    destroy();
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(const FlatHashSet& s)
+    : hashFunction{s.hashFunction}, control{nullptr}, slots{nullptr},
+      total_capacity{0}, total_size{0}
+{
+    copy_from(s);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>::FlatHashSet(FlatHashSet&& s) noexcept
+    : hashFunction{s.hashFunction}, control{nullptr}, slots{nullptr},
+      total_capacity{0}, total_size{0}
+{
+    std::swap(control, s.control);
+    std::swap(slots, s.slots);
+    std::swap(total_capacity, s.total_capacity);
+    std::swap(total_size, s.total_size);
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>& FlatHashSet<ElementType>::operator=(const FlatHashSet& s)
+{
+    if (this != &s)
+    {
+        destroy();
+        hashFunction = s.hashFunction;
+        copy_from(s);
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+FlatHashSet<ElementType>& FlatHashSet<ElementType>::operator=(FlatHashSet&& s) noexcept
+{
+    std::swap(hashFunction, s.hashFunction);
+    std::swap(control, s.control);
+    std::swap(slots, s.slots);
+    std::swap(total_capacity, s.total_capacity);
+    std::swap(total_size, s.total_size);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void FlatHashSet<ElementType>::add(const ElementType& element)
+{
+    // The element is hashed once, and one probe either finds it or finds
+    // the slot it belongs in.  Only when the set has to grow first is that
+    // slot no good, in which case the element is placed in the grown set
+    // using the same hash.
+    if (control == nullptr)
+    {
+        allocate(DEFAULT_CAPACITY);
+    }
+
+    unsigned int hash = mix(hashFunction(element));
+    bool found;
+    unsigned int index = probe(element, hash, found);
+
+    if (found)
+    {
+        return;
+    }
+
+    if (static_cast<unsigned long long>(total_size + 1) * 8 > total_capacity * 7ull)
+    {
+        grow();
+        insert_unique(element, hash);
+    }
+    else
+    {
+        place(index, element, hash);
+    }
+}
+
+
+template <typename ElementType>
+bool FlatHashSet<ElementType>::contains(const ElementType& element) const
+{
+    if (total_size == 0)
+    {
+        return false;
+    }
+
+    bool found;
+    probe(element, mix(hashFunction(element)), found);
+    return found;
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::size() const noexcept
+{
+    return total_size;
+}
+
+
+template <typename ElementType>
+unsigned int FlatHashSet<ElementType>::capacity() const noexcept
+{
+    return total_capacity;
+}
+
+
+
+#endif // FLATHASHSET_HPP
+
@@ -0,0 +1,290 @@
+// FlatHashSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for the open-addressed FlatHashSet.  Several of these use a
+// hash function that sends every element to the same place, which forces
+// the probing to walk across groups and the tags to collide.
+
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "FlatHashSet.hpp"
+
+
+namespace
+{
+    template <typename T>
+    unsigned int zeroHash(const T&)
+    {
+        return 0;
+    }
+
+
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    unsigned int countingHashCalls = 0;
+
+    unsigned int countingHash(const int& i)
+    {
+        countingHashCalls++;
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(FlatHashSet_Tests, inheritFromSet)
+{
+    FlatHashSet<std::string> s{zeroHash<std::string>};
+    Set<std::string>& ss = s;
+    EXPECT_EQ(0, ss.size());
+    EXPECT_TRUE(ss.isImplemented());
+}
+
+
+TEST(FlatHashSet_Tests, containsElementsAfterAdding)
+{
+    FlatHashSet<int> s{identityHash};
+    s.add(11);
+    s.add(1);
+    s.add(5);
+
+    EXPECT_TRUE(s.contains(11));
+    EXPECT_TRUE(s.contains(1));
+    EXPECT_TRUE(s.contains(5));
+    EXPECT_FALSE(s.contains(2));
+    EXPECT_EQ(3, s.size());
+}
+
+
+TEST(FlatHashSet_Tests, addingDuplicatesHasNoEffect)
+{
+    FlatHashSet<int> s{identityHash};
+    s.add(7);
+    s.add(7);
+    s.add(7);
+
+    EXPECT_EQ(1, s.size());
+}
+
+
+TEST(FlatHashSet_Tests, addHashesEachElementOnce)
+{
+    FlatHashSet<int> s{countingHash};
+    s.add(1);
+
+    countingHashCalls = 0;
+    s.add(2);
+    EXPECT_EQ(1, countingHashCalls);
+
+    countingHashCalls = 0;
+    s.add(2);
+    EXPECT_EQ(1, countingHashCalls);
+
+    // Growing hashes the elements already in the set, but the new one is
+    // still only hashed once.
+    for (int i = 3; i <= 14; ++i)
+    {
+        s.add(i);
+    }
+
+    unsigned int capacity = s.capacity();
+    countingHashCalls = 0;
+    s.add(15);
+    ASSERT_LT(capacity, s.capacity());
+    EXPECT_EQ(15, countingHashCalls);
+    EXPECT_EQ(15, s.size());
+
+    for (int i = 1; i <= 15; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+}
+
+
+TEST(FlatHashSet_Tests, growsPastManyGroupsWithCollidingHashes)
+{
+    FlatHashSet<int> s{zeroHash<int>};
+
+    for (int i = 0; i < 200; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(200, s.size());
+    EXPECT_GE(s.capacity() * 7, s.size() * 8);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+    }
+
+    EXPECT_FALSE(s.contains(200));
+    EXPECT_FALSE(s.contains(-1));
+}
+
+
+TEST(FlatHashSet_Tests, manyStringsSurviveResizing)
+{
+    FlatHashSet<std::string> s{[](const std::string& str)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(str));
+    }};
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    EXPECT_EQ(10000, s.size());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_TRUE(s.contains("WORD" + std::to_string(i)));
+        EXPECT_FALSE(s.contains("DROW" + std::to_string(i)));
+    }
+}
+
+
+TEST(FlatHashSet_Tests, copiesAreIndependent)
+{
+    FlatHashSet<std::string> s1{zeroHash<std::string>};
+    s1.add("HELLO");
+
+    FlatHashSet<std::string> s2{s1};
+    s2.add("THERE");
+
+    FlatHashSet<std::string> s3{zeroHash<std::string>};
+    s3 = s2;
+    s3.add("BOO");
+
+    EXPECT_EQ(1, s1.size());
+    EXPECT_EQ(2, s2.size());
+    EXPECT_EQ(3, s3.size());
+    EXPECT_FALSE(s1.contains("THERE"));
+    EXPECT_TRUE(s2.contains("HELLO"));
+    EXPECT_TRUE(s3.contains("THERE"));
+}
+
+
+TEST(FlatHashSet_Tests, movedFromSetIsStillUsable)
+{
+    FlatHashSet<std::string> s1{zeroHash<std::string>};
+    s1.add("HELLO");
+
+    FlatHashSet<std::string> s2{std::move(s1)};
+    EXPECT_TRUE(s2.contains("HELLO"));
+
+    s1.add("THERE");
+    EXPECT_TRUE(s1.contains("THERE"));
+    EXPECT_EQ(1, s1.size());
+}
+
+
+TEST(FlatHashSet_Tests, copyOfMovedFromSetIsStillUsable)
+{
+    FlatHashSet<int> s1{identityHash};
+    s1.add(1);
+
+    FlatHashSet<int> s2{std::move(s1)};
+
+    FlatHashSet<int> s3{s1};
+    FlatHashSet<int> s4{identityHash};
+    s4 = s1;
+
+    for (int i = 0; i < 50; ++i)
+    {
+        s3.add(i);
+        s4.add(i);
+    }
+
+    EXPECT_EQ(50, s3.size());
+    EXPECT_EQ(50, s4.size());
+    EXPECT_TRUE(s3.contains(49));
+    EXPECT_TRUE(s4.contains(0));
+    EXPECT_FALSE(s3.contains(50));
+}
+
+
+
+TEST(FlatHashSet_Tests, failedGrowthLeavesTheSetUnchanged)
+{
+    bool failing = false;
+
+    FlatHashSet<int> s{[&](const int& i)
+    {
+        if (failing && i == 3)
+        {
+            throw std::runtime_error{"hash failed"};
+        }
+
+        return static_cast<unsigned int>(i);
+    }};
+
+    unsigned int added = 0;
+
+    while (added * 8 + 8 <= s.capacity() * 7)
+    {
+        s.add(static_cast<int>(added++));
+    }
+
+    unsigned int capacity = s.capacity();
+    failing = true;
+    EXPECT_THROW(s.add(1000), std::runtime_error);
+
+    EXPECT_EQ(capacity, s.capacity());
+    EXPECT_EQ(added, s.size());
+
+    failing = false;
+
+    for (unsigned int i = 0; i < added; ++i)
+    {
+        EXPECT_TRUE(s.contains(static_cast<int>(i)));
+    }
+
+    s.add(1000);
+    EXPECT_TRUE(s.contains(1000));
+    EXPECT_EQ(added + 1, s.size());
+}
+
+
+TEST(FlatHashSet_Tests, failedGrowthKeepsStringsThatWouldBeMoved)
+{
+    // The strings are long enough that a moved-from one would be empty, and
+    // the hash function fails partway through the growth.
+    unsigned int hashesUntilFailure = 0;
+
+    FlatHashSet<std::string> s{[&](const std::string& str)
+    {
+        if (hashesUntilFailure != 0 && --hashesUntilFailure == 0)
+        {
+            throw std::runtime_error{"hash failed"};
+        }
+
+        return static_cast<unsigned int>(std::hash<std::string>{}(str));
+    }};
+
+    unsigned int added = 0;
+
+    while (added * 8 + 8 <= s.capacity() * 7)
+    {
+        s.add("A LONG DICTIONARY WORD " + std::to_string(added++));
+    }
+
+    hashesUntilFailure = added / 2 + 1;
+    EXPECT_THROW(s.add("ONE MORE LONG DICTIONARY WORD"), std::runtime_error);
+
+    for (unsigned int i = 0; i < added; ++i)
+    {
+        EXPECT_TRUE(s.contains("A LONG DICTIONARY WORD " + std::to_string(i))) << i;
+    }
+
+    s.add("ONE MORE LONG DICTIONARY WORD");
+    EXPECT_TRUE(s.contains("ONE MORE LONG DICTIONARY WORD"));
+    EXPECT_EQ(added + 1, s.size());
+}
@@ -0,0 +1,282 @@
+// FrozenSortedSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A FrozenSortedSet is a read-only Set, built once from the contents of a
+// sorted Set such as an AVLSet, e.g.,
+//
+//     AVLSet<std::string> words;
+//     ...
+//     FrozenSortedSet<std::string> frozen{words};
+//     WordChecker checker{frozen};
+//
+// Its elements are stored in one array in "Eytzinger" order, which is the
+// order in which a breadth-first traversal would visit them if they were
+// in a perfectly balanced binary search tree: element 1 is the root, and
+// the children of element k are elements 2k and 2k + 1.  Searching it is
+// like searching a binary search tree, except that there are no pointers
+// to follow; the next element to look at is computed from the index of the
+// current one and the result of one comparison, which the compiler can do
+// without a branch, so there are no mispredicted branches either.
+//
+// Because the descendants of element k a few levels down are next to one
+// another in the array, the cache line holding them can be requested (with
+// a prefetch) before the search reaches them, so that a search waits for
+// memory far less often than it would following pointers through nodes
+// scattered across the heap.
+//
+// Since a FrozenSortedSet can't change once it's been built, add() throws
+// a std::logic_error.
+
+#ifndef FROZENSORTEDSET_HPP
+#define FROZENSORTEDSET_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+
+template <typename ElementType>
+class FrozenSortedSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, FrozenSortedSet<ElementType>>
+{
+public:
+    // Initializes a FrozenSortedSet to be empty.
+    FrozenSortedSet();
+
+    // Initializes a FrozenSortedSet to contain the elements of the given
+    // set, which must have an inorder() function that visits its elements
+    // in ascending order, as AVLSet does.
+    template <typename SortedSet>
+    explicit FrozenSortedSet(const SortedSet& s);
+
+    // Cleans up the FrozenSortedSet so that it leaks no memory.
+    virtual ~FrozenSortedSet() noexcept;
+
+    // Initializes a new FrozenSortedSet to be a copy of an existing one.
+    FrozenSortedSet(const FrozenSortedSet& s);
+
+    // Initializes a new FrozenSortedSet whose contents are moved from an
+    // expiring one.
+    FrozenSortedSet(FrozenSortedSet&& s) noexcept;
+
+    // Assigns an existing FrozenSortedSet into another.
+    FrozenSortedSet& operator=(const FrozenSortedSet& s);
+
+    // Assigns an expiring FrozenSortedSet into another.
+    FrozenSortedSet& operator=(FrozenSortedSet&& s) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() always throws a std::logic_error, because a FrozenSortedSet
+    // can't be changed.
+    virtual void add(const ElementType& element) override;
+
+
+    // contains() returns true if the given element is in the set, false
+    // otherwise.  This function always runs in O(log n) time.
+    virtual bool contains(const ElementType& element) const override;
+
+
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements using == and <, such as a
+    // std::string_view when the elements are std::strings.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const noexcept override;
+
+
+private:
+    // The number of elements that fit in a cache line, rounded down to a
+    // power of two.  The elements PREFETCH_SPAN * k through
+    // PREFETCH_SPAN * k + PREFETCH_SPAN - 1 are the descendants of element
+    // k that are log2(PREFETCH_SPAN) levels below it.
+    static constexpr std::size_t PREFETCH_SPAN =
+        sizeof(ElementType) >= 64 ? 1
+        : sizeof(ElementType) >= 32 ? 2
+        : sizeof(ElementType) >= 16 ? 4
+        : sizeof(ElementType) >= 8 ? 8
+        : 16;
+
+    // elements[0] is unused, so that element k's children are at 2k and
+    // 2k + 1.  A FrozenSortedSet that has been moved from has no array at
+    // all, in which case elements is nullptr and count is 0.
+    ElementType* elements;
+    unsigned int count;
+
+    template <typename Iterator>
+    void lay_out(ElementType* cells, Iterator& next, std::size_t k) const;
+};
+
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>::FrozenSortedSet()
+    : elements{new ElementType[1]}, count{0}
+{
+}
+
+
+template <typename ElementType>
+template <typename SortedSet>
+FrozenSortedSet<ElementType>::FrozenSortedSet(const SortedSet& s)
+    : elements{nullptr}, count{s.size()}
+{
+    // Nothing is owned by the set until the layout is finished, so that
+    // an exception part-way through leaks nothing.
+    std::vector<ElementType> sorted;
+    sorted.reserve(count);
+    s.inorder([&](const ElementType& element) { sorted.push_back(element); });
+
+    std::unique_ptr<ElementType[]> cells{new ElementType[count + 1]};
+    auto next = sorted.begin();
+    lay_out(cells.get(), next, 1);
+
+    elements = cells.release();
+}
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>::~FrozenSortedSet() noexcept
+{
+    delete[] elements;
+}
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>::FrozenSortedSet(const FrozenSortedSet& s)
+    : elements{new ElementType[s.count + 1]}, count{s.count}
+{
+    if (s.elements != nullptr)
+    {
+        std::copy(s.elements, s.elements + count + 1, elements);
+    }
+}
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>::FrozenSortedSet(FrozenSortedSet&& s) noexcept
+    : elements{nullptr}, count{0}
+{
+    std::swap(elements, s.elements);
+    std::swap(count, s.count);
+}
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>& FrozenSortedSet<ElementType>::operator=(const FrozenSortedSet& s)
+{
+    if (this != &s)
+    {
+        ElementType* copied = new ElementType[s.count + 1];
+
+        if (s.elements != nullptr)
+        {
+            std::copy(s.elements, s.elements + s.count + 1, copied);
+        }
+
+        delete[] elements;
+        elements = copied;
+        count = s.count;
+    }
+
+    return *this;
+}
+
+
+template <typename ElementType>
+FrozenSortedSet<ElementType>& FrozenSortedSet<ElementType>::operator=(FrozenSortedSet&& s) noexcept
+{
+    std::swap(elements, s.elements);
+    std::swap(count, s.count);
+    return *this;
+}
+
+
+template <typename ElementType>
+bool FrozenSortedSet<ElementType>::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+template <typename ElementType>
+void FrozenSortedSet<ElementType>::add(const ElementType&)
+{
+    throw std::logic_error{"FrozenSortedSet can't be added to"};
+}
+
+
+template <typename ElementType>
+bool FrozenSortedSet<ElementType>::contains(const ElementType& element) const
+{
+    return containsKey(element);
+}
+
+
+template <typename ElementType>
+template <typename Key>
+bool FrozenSortedSet<ElementType>::containsKey(const Key& key) const
+{
+    // Each step goes to the left child (2k) if the key isn't greater than
+    // element k, and the right child (2k + 1) otherwise.  Once the search
+    // falls off the bottom of the tree, k's bits record every turn it took;
+    // the last time it went left was at the smallest element not less than
+    // the key, which is found by discarding the trailing right turns (the
+    // 1 bits) and the left turn before them.
+    std::size_t k = 1;
+
+    while (k <= count)
+    {
+        // Near the bottom of the tree, the descendants are past the end of
+        // the array, so the last element is prefetched instead (without a
+        // branch, since std::min compiles to a conditional move).
+        __builtin_prefetch(elements + std::min(PREFETCH_SPAN * k, std::size_t{count}));
+        k = 2 * k + static_cast<std::size_t>(elements[k] < key);
+    }
+
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+
+    return k != 0 && elements[k] == key;
+}
+
+
+template <typename ElementType>
+unsigned int FrozenSortedSet<ElementType>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType>
+template <typename Iterator>
+void FrozenSortedSet<ElementType>::lay_out(
+    ElementType* cells, Iterator& next, std::size_t k) const
+{
+    // An inorder traversal of the implicit tree visits its cells in
+    // ascending order, so it's filled by handing them the sorted elements
+    // in that order.
+    if (k <= count)
+    {
+        lay_out(cells, next, 2 * k);
+        cells[k] = std::move(*next++);
+        lay_out(cells, next, 2 * k + 1);
+    }
+}
+
+
+
+#endif // FROZENSORTEDSET_HPP
+
@@ -0,0 +1,86 @@
+// FrozenSortedSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing FrozenSortedSet with the AVLSet it's built from.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmark.hpp"
+#include "FrozenSortedSet.hpp"
+
+
+namespace
+{
+    template <typename SetType, typename ElementType>
+    double nanosPerLookup(const SetType& set, const std::vector<ElementType>& queries)
+    {
+        bench::Stopwatch watch;
+        unsigned int found = 0;
+
+        for (const ElementType& query : queries)
+        {
+            found += set.contains(query) ? 1 : 0;
+        }
+
+        bench::doNotOptimize(found);
+        return bench::nanosPerOperation(watch, queries.size());
+    }
+
+
+    // Builds each kind of set from the given elements (added in the order
+    // given, so that the AVLSet's nodes are scattered as they would be
+    // after loading an unsorted file), then looks up a shuffled mix of the
+    // elements and the given missing ones.
+    template <typename ElementType>
+    void compareLookups(
+        const char* label, const std::vector<ElementType>& elements,
+        const std::vector<ElementType>& missing)
+    {
+        AVLSet<ElementType, HeapNodes> heapTree;
+        AVLSet<ElementType, NodePool> pooledTree;
+
+        for (const ElementType& element : elements)
+        {
+            heapTree.add(element);
+            pooledTree.add(element);
+        }
+
+        FrozenSortedSet<ElementType> frozen{pooledTree};
+
+        std::vector<ElementType> queries = elements;
+        queries.insert(queries.end(), missing.begin(), missing.end());
+        std::shuffle(queries.begin(), queries.end(), std::mt19937{17});
+
+        std::printf("  %-8s %8zu  AVLSet (heap) %6.1f ns  AVLSet (pool) %6.1f ns  frozen %6.1f ns\n",
+            label, elements.size(), nanosPerLookup(heapTree, queries),
+            nanosPerLookup(pooledTree, queries), nanosPerLookup(frozen, queries));
+    }
+}
+
+
+BENCHMARK(FrozenSortedSet, lookupVersusAVLSet)
+{
+    for (unsigned int size : {10000u, 100000u, 1000000u})
+    {
+        std::vector<unsigned int> numbers;
+        std::vector<unsigned int> missingNumbers;
+        std::mt19937 engine{size};
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            // Even numbers are in the set and odd numbers aren't.
+            numbers.push_back(engine() & ~1u);
+            missingNumbers.push_back(engine() | 1u);
+        }
+
+        compareLookups("ints", numbers, missingNumbers);
+        compareLookups("words", bench::makeWords(size, 14), bench::makeWords(size, 15));
+    }
+}
+
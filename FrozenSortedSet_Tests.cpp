@@ -0,0 +1,125 @@
+// FrozenSortedSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for FrozenSortedSet.
+
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "FrozenSortedSet.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(FrozenSortedSet_Tests, emptySetContainsNothing)
+{
+    FrozenSortedSet<int> s;
+    FrozenSortedSet<int> fromEmpty{AVLSet<int>{}};
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_EQ(0, fromEmpty.size());
+    EXPECT_FALSE(fromEmpty.contains(0));
+}
+
+
+TEST(FrozenSortedSet_Tests, containsTheSameElementsAsTheAVLSet)
+{
+    // Every size up to 70 checks trees with every shape of bottom level.
+    for (int size = 1; size <= 70; ++size)
+    {
+        AVLSet<int> tree;
+
+        for (int i = 0; i < size; ++i)
+        {
+            tree.add(i * 3);
+        }
+
+        FrozenSortedSet<int> frozen{tree};
+        EXPECT_EQ(size, frozen.size());
+
+        for (int i = -3; i <= size * 3 + 3; ++i)
+        {
+            EXPECT_EQ(tree.contains(i), frozen.contains(i)) << size << " " << i;
+        }
+    }
+}
+
+
+TEST(FrozenSortedSet_Tests, containsRandomElements)
+{
+    std::mt19937 engine{46};
+    AVLSet<unsigned int> tree;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        tree.add(engine() % 50000);
+    }
+
+    FrozenSortedSet<unsigned int> frozen{tree};
+    FrozenSortedSet<unsigned int> copy;
+    copy = frozen;
+
+    EXPECT_EQ(tree.size(), copy.size());
+
+    for (unsigned int i = 0; i < 50000; ++i)
+    {
+        EXPECT_EQ(tree.contains(i), copy.contains(i)) << i;
+    }
+}
+
+
+TEST(FrozenSortedSet_Tests, cannotBeAddedTo)
+{
+    AVLSet<std::string> tree;
+    tree.add("FROZEN");
+
+    FrozenSortedSet<std::string> frozen{tree};
+
+    EXPECT_THROW(frozen.add("THAWED"), std::logic_error);
+    EXPECT_EQ(1, frozen.size());
+}
+
+
+TEST(FrozenSortedSet_Tests, canBeUsedByAWordChecker)
+{
+    AVLSet<std::string> tree;
+    tree.add("CAT");
+    tree.add("CART");
+    tree.add("AT");
+
+    FrozenSortedSet<std::string> frozen{tree};
+    WordChecker checker{frozen};
+    const StringViewLookup& lookup = frozen;
+
+    EXPECT_TRUE(checker.wordExists("CART"));
+    EXPECT_FALSE(checker.wordExists("CAR"));
+    EXPECT_TRUE(lookup.containsView(std::string_view{"CATS"}.substr(1, 2)));
+    EXPECT_EQ((std::vector<std::string>{"CART", "AT", "CAT"}), checker.findSuggestions("CAT"));
+}
+
+
+TEST(FrozenSortedSet_Tests, movedFromSetCanBeCopied)
+{
+    AVLSet<std::string> tree;
+    tree.add("MOVED");
+
+    FrozenSortedSet<std::string> frozen{tree};
+    FrozenSortedSet<std::string> moved{std::move(frozen)};
+
+    FrozenSortedSet<std::string> copy{frozen};
+    FrozenSortedSet<std::string> assigned{moved};
+    assigned = frozen;
+
+    EXPECT_EQ(0, copy.size());
+    EXPECT_FALSE(copy.contains("MOVED"));
+    EXPECT_EQ(0, assigned.size());
+    EXPECT_FALSE(assigned.contains("MOVED"));
+    EXPECT_TRUE(moved.contains("MOVED"));
+}
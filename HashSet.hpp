@@ -12,7 +12,38 @@
 // As elements are added to the HashSet and the proportion of the HashSet's
 // size to its capacity exceeds 0.8 (i.e., there are more than 80% as many
 // elements as there are array cells), the HashSet should be resized so
-// that it is twice as large as it was before.
+// that it is twice as large as it was before.  The capacity is always a
+// power of two, so an element's index is just the low bits of its hash.
+//
+// Elements are hashed either by a HashFunction given to the constructor
+// or, if none is given, by the HashPolicy named in the HashSet's type
+// (see Hashing.hpp), which defaults to DefaultHash.  A HashFunction is a
+// std::function, so every call to it is an indirect call; a HashPolicy
+// call can be inlined, which makes it the faster choice for lookups.
+//
+// Normally, that resizing is done all at once, within the add() call that
+// crosses the threshold.  A HashSet can instead be asked to resize
+// incrementally, in which case it keeps the old array alongside the new
+// one and moves the contents of MIGRATION_STEP of the old array's cells
+// into the new one on each call to add() or contains(), so no one call
+// ever does more than a bounded amount of resizing work.  (Note that this
+// means contains() modifies the HashSet while a resize is in progress, so
+// an incrementally-resizing HashSet shouldn't be shared between threads
+// without synchronization, unless finishResizing() has been called since
+// the last add().)
+//
+// The nodes are created and destroyed by the NodeAllocator named in the
+// HashSet's type (see NodePool.hpp), which defaults to a NodePool.
+//
+// A HashSet of strings can be saved to a file and loaded back later.  The
+// file holds the array's capacity and, bucket by bucket, each key with
+// its stored hash, so loading one puts every key back in the bucket (and
+// the position in its bucket) it came from, without hashing any of them
+// or resizing along the way.  Since the stored hashes are only good for
+// the hash function that computed them, the file also records the hash
+// of a fixed string, and loading a file whose hash of it differs from
+// the HashSet's own fails rather than building a HashSet that can't find
+// anything.
 //
 // You are not permitted to use the containers in the C++ Standard Library
 // (such as std::set, std::map, or std::vector) to store the information
@@ -23,27 +54,58 @@
 #ifndef HASHSET_HPP
 #define HASHSET_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Hashing.hpp"
+#include "NodePool.hpp"
 #include "Set.hpp"
+#include "StringLookup.hpp"
 using namespace std;
 
 
-template <typename ElementType>
-class HashSet : public Set<ElementType>
+template <typename ElementType, typename HashPolicy = DefaultHash<ElementType>,
+    template <typename> typename NodeAllocator = NodePool>
+class HashSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, HashSet<ElementType, HashPolicy, NodeAllocator>>
 {
 public:
     // The default capacity of the HashSet before anything has been
     // added to it.
-    static constexpr unsigned int DEFAULT_CAPACITY = 10;
+    static constexpr unsigned int DEFAULT_CAPACITY = 16;
+
+    // The number of cells of the old array whose contents are moved into
+    // the new one during each add() or contains() call, when resizing
+    // incrementally.  Any value of at least 2 guarantees that a resize
+    // finishes before the next one is needed.
+    static constexpr unsigned int MIGRATION_STEP = 8;
 
     // A HashFunction is a function that takes a reference to a const
     // ElementType and returns an unsigned int.
     using HashFunction = std::function<unsigned int(const ElementType&)>;
 
 public:
+    // Initializes a HashSet to be empty, so that it will use its HashPolicy
+    // whenever it needs to hash an element.
+    HashSet();
+
+    // Initializes a HashSet to be empty, so that it will use the given
+    // HashPolicy object whenever it needs to hash an element.  If
+    // incrementalResizing is true, resizing is spread out across many
+    // calls to add() and contains() rather than done all at once.
+    explicit HashSet(HashPolicy hashPolicy, bool incrementalResizing = false);
+
     // Initializes a HashSet to be empty, so that it will use the given
-    // hash function whenever it needs to hash an element.
-    explicit HashSet(HashFunction hashFunction);
+    // hash function whenever it needs to hash an element.  If
+    // incrementalResizing is true, resizing is spread out across many
+    // calls to add() and contains() rather than done all at once.
+    explicit HashSet(HashFunction hashFunction, bool incrementalResizing = false);
 
     // Cleans up the HashSet so that it leaks no memory.
     virtual ~HashSet() noexcept;
@@ -73,7 +135,8 @@ public:
     // where the array is resized, this function runs in linear time (with
     // respect to the number of elements, assuming a good hash function);
     // otherwise, it runs in constant time (again, assuming a good hash
-    // function).
+    // function).  When resizing incrementally, it always runs in constant
+    // time.
     virtual void add(const ElementType& element) override;
 
 
@@ -83,6 +146,15 @@ public:
     virtual bool contains(const ElementType& element) const override;
 
 
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements and is hashed the same way, such as
+    // a std::string_view when the elements are std::strings.  When the
+    // hash policy can't hash the key directly (or a HashFunction was
+    // given), the key is converted to an ElementType to be hashed.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept override;
 
@@ -99,61 +171,165 @@ public:
     bool isElementAtIndex(const ElementType& element, unsigned int index) const;
 
 
+    // isResizing() returns true if an incremental resize is in progress,
+    // i.e., some elements are still stored in the old array.
+    bool isResizing() const noexcept;
+
+
+    // finishResizing() completes an incremental resize that's in progress,
+    // if there is one, so that contains() no longer modifies the HashSet
+    // until the next add().
+    void finishResizing();
+
+
+    // resizeProgress() returns the fraction of the old array's cells whose
+    // contents have been moved into the new one, from 0.0 when a resize has
+    // just started to 1.0 when no resize is in progress.
+    double resizeProgress() const noexcept;
+
+
+    // save() writes the set's contents to the file at the given path,
+    // replacing it if it exists.  It can only be called on a HashSet of
+    // std::strings, and throws a std::runtime_error if the file can't be
+    // written.
+    void save(const std::string& path) const;
+
+
+    // load() replaces the set's contents with the ones saved in the file
+    // at the given path.  The file is read a block at a time into buffers
+    // that are reused from one block to the next, and each key is placed
+    // directly into its saved bucket.  It can only be called on a HashSet
+    // of std::strings whose hash function is the same as the one that
+    // saved the file.  If the file can't be read, isn't a saved HashSet,
+    // or was saved with a different hash function, it throws a
+    // std::runtime_error and leaves the set unchanged.
+    void load(const std::string& path);
+
+
 private:
+    // A saved HashSet is a FileHeader followed by its nodes, in blocks of
+    // up to FILE_BLOCK nodes.  Each block is the block's FileRecords (each
+    // node's stored hash and key length) followed by the characters of
+    // their keys, one after another.  Each bucket's nodes are saved in
+    // reverse order, so that adding each one to the front of its bucket
+    // as it's loaded rebuilds the bucket in its original order.
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t endianCheck;
+        std::uint32_t hashCheck;
+        std::uint32_t capacity;
+        std::uint32_t count;
+        std::uint64_t keyBytes;
+    };
+
+    struct FileRecord
+    {
+        std::uint32_t hashValue;
+        std::uint32_t length;
+    };
+
+    static constexpr char FILE_MAGIC[8] = {'I', 'C', 'S', '4', '6', 'H', 'S', 'H'};
+    static constexpr std::uint32_t FILE_ENDIAN_CHECK = 0x01020304;
+    static constexpr unsigned int FILE_BLOCK = 4096;
+
     HashFunction hashFunction;
+    HashPolicy hashPolicy;
+    // Each node remembers the full hash of its key, so that the key never
+    // needs to be hashed again once it's been added: resizing uses the
+    // stored hash to find the node's new index, and lookups compare the
+    // stored hash before comparing keys.
     struct Nodes
     {
         ElementType key;
+        unsigned int hashValue;
         Nodes* next = nullptr;
 
         
-        Nodes(const ElementType& value, Nodes* next =nullptr):key(value),next(next)
+        Nodes(const ElementType& value, unsigned int hashValue, Nodes* next =nullptr)
+            :key(value),hashValue(hashValue),next(next)
         {}
         
 
 };
+    NodeAllocator<Nodes> node_allocator;
     Nodes** hash;
     unsigned int total_capacity;
     float total_size = 0.0;
-    void add_node(const ElementType& element,Nodes** hash);
+
+    // While an incremental resize is in progress, old_hash is the array
+    // being resized away from, and the cells before index "migrated" have
+    // already had their contents moved into hash.  Otherwise, old_hash
+    // is nullptr.
+    bool incremental = false;
+    mutable Nodes** old_hash = nullptr;
+    unsigned int old_capacity = 0;
+    mutable unsigned int migrated = 0;
+
+    template <typename Key>
+    unsigned int hash_of(const Key& key) const;
+    void add_node(const ElementType& element, unsigned int hashValue);
     Nodes* copy_hash(Nodes* n);
-    void resize_hash(Nodes** n,const ElementType& element);
-    void delete_node(Nodes** n);
+    void copy_from(const HashSet& s);
+    template <typename Key>
+    bool find_node(const Key& key, unsigned int hashValue) const;
+    void start_resize();
+    void migrate_buckets(unsigned int count) const;
+    void resize_hash();
+    void delete_node(Nodes** n, unsigned int capacity);
+    std::uint32_t file_hash_check() const;
 
 };
 
 
 
-namespace impl_
+///--------------------------------------Helper Function---------------------------------------
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+template <typename Key>
+unsigned int HashSet<ElementType, HashPolicy, NodeAllocator>::hash_of(const Key& key) const
 {
-    template <typename ElementType>
-    unsigned int HashSet__undefinedHashFunction(const ElementType& element)
+    // An empty hashFunction means that none was given to the constructor.
+    if(hashFunction)
     {
-        return 0;
+        if constexpr (std::is_convertible_v<const Key&, const ElementType&>)
+        {
+            return static_cast<unsigned int>(hashFunction(key));
+        }
+        else
+        {
+            return static_cast<unsigned int>(hashFunction(ElementType{key}));
+        }
     }
-}
-///--------------------------------------Helper Function---------------------------------------
-template <typename ElementType>
-void HashSet<ElementType>::add_node(const ElementType& element,Nodes** hash)
-{
-    
-    unsigned int index = static_cast<unsigned int>(hashFunction(element)) % total_capacity;
-    
-    if(hash[index] == nullptr)
+
+    if constexpr (std::is_invocable_v<const HashPolicy&, const Key&>)
     {
-        hash[index] = new Nodes{element,nullptr};
+        return static_cast<unsigned int>(hashPolicy(key));
+    }
+    else if constexpr (std::is_invocable_v<const HashPolicy&, const ElementType&>)
+    {
+        return static_cast<unsigned int>(hashPolicy(ElementType{key}));
     }
     else
-    {           
-        
-        hash[index] = new Nodes{element,hash[index]};
-       
+    {
+        // A HashPolicy that can't hash an ElementType (e.g., DefaultHash
+        // of a type with no std::hash) can only be used alongside a hash
+        // function, so the only way here is an empty one.
+        throw std::bad_function_call{};
     }
+}
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::add_node(const ElementType& element, unsigned int hashValue)
+{
+    
+    unsigned int index = hashValue & (total_capacity - 1);
+    
+    hash[index] = node_allocator.create(element,hashValue,hash[index]);
     total_size+=1;
 }
 
-template<typename ElementType>
-typename HashSet<ElementType>::Nodes* HashSet<ElementType>::copy_hash(Nodes* n)
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+typename HashSet<ElementType, HashPolicy, NodeAllocator>::Nodes* HashSet<ElementType, HashPolicy, NodeAllocator>::copy_hash(Nodes* n)
 {
     try
     {
@@ -163,7 +339,7 @@ typename HashSet<ElementType>::Nodes* HashSet<ElementType>::copy_hash(Nodes* n)
         }
         else 
         {
-            return new Nodes(n->key,copy_hash(n->next));
+            return node_allocator.create(n->key,n->hashValue,copy_hash(n->next));
         }
     }
     catch(...)
@@ -172,40 +348,132 @@ typename HashSet<ElementType>::Nodes* HashSet<ElementType>::copy_hash(Nodes* n)
     }
 }
 
-template <typename ElementType>
-void HashSet<ElementType>::resize_hash(Nodes** n,const ElementType& element)
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::copy_from(const HashSet& s)
 {
-    Nodes** old_hash = hash;
-    total_capacity = total_capacity * 2;
-
+    total_capacity = s.total_capacity;
     hash = new Nodes*[total_capacity];
-
-    for(int i=0;i<total_capacity;i++)
+    for(unsigned int i=0;i<total_capacity;i++)
     {
         hash[i]=nullptr;
     }
+    total_size = s.total_size;
+    for(unsigned int i = 0;i<total_capacity;i++)
+    {
+        if(s.hash[i]!=nullptr)
+        {
+            hash[i]=copy_hash(s.hash[i]);
+        }
+    }
 
-    for(int m=0;m<total_capacity/2;m++)
+    // If s is partway through an incremental resize, the copy gets the
+    // elements that haven't moved yet placed directly into its one array.
+    if(s.old_hash != nullptr)
     {
-        if(old_hash[m]!=nullptr)
+        for(unsigned int m = s.migrated;m<s.old_capacity;m++)
         {
-            Nodes* temp = old_hash[m];
-            while(temp!=nullptr)
+            for(Nodes* temp = s.old_hash[m];temp!=nullptr;temp = temp -> next)
             {
-                add_node(temp->key,hash);
-                temp = temp -> next;
+                unsigned int index = temp -> hashValue & (total_capacity - 1);
+                hash[index] = node_allocator.create(temp->key,temp->hashValue,hash[index]);
             }
         }
     }
+}
 
-    
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+template <typename Key>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::find_node(const Key& element, unsigned int hashValue) const
+{
+    for(Nodes* n = hash[hashValue & (total_capacity - 1)];n!=nullptr;n = n -> next)
+    {
+        if(n->hashValue == hashValue && n->key == element)
+        {
+            return true;
+        }
+    }
+
+    if(old_hash != nullptr)
+    {
+        unsigned int old_index = hashValue & (old_capacity - 1);
+        if(old_index >= migrated)
+        {
+            for(Nodes* n = old_hash[old_index];n!=nullptr;n = n -> next)
+            {
+                if(n->hashValue == hashValue && n->key == element)
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::start_resize()
+{
+    // A new resize can't begin until the previous one has finished, though
+    // with MIGRATION_STEP of at least 2, it always will have by now.
+    migrate_buckets(old_capacity);
+
+    Nodes** new_hash = new Nodes*[total_capacity * 2];
+    for(unsigned int i=0;i<total_capacity * 2;i++)
+    {
+        new_hash[i]=nullptr;
+    }
+
+    old_hash = hash;
+    old_capacity = total_capacity;
+    migrated = 0;
+    hash = new_hash;
+    total_capacity = old_capacity * 2;
+}
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::migrate_buckets(unsigned int count) const
+{
+    // The existing nodes are relinked into the new array using their
+    // stored hashes, so resizing neither hashes nor allocates any nodes.
+    for(;count > 0 && old_hash != nullptr;count--)
+    {
+        Nodes* temp = old_hash[migrated];
+        while(temp!=nullptr)
+        {
+            Nodes* next = temp -> next;
+            unsigned int index = temp -> hashValue & (total_capacity - 1);
+            temp -> next = hash[index];
+            hash[index] = temp;
+            temp = next;
+        }
+        old_hash[migrated] = nullptr;
+        migrated++;
+
+        if(migrated == old_capacity)
+        {
+            delete[] old_hash;
+            old_hash = nullptr;
+        }
+    }
 }
 
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::resize_hash()
+{
+    start_resize();
+    migrate_buckets(old_capacity);
+}
 
-template <typename ElementType>
-void HashSet<ElementType>::delete_node(Nodes** n)
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::delete_node(Nodes** n, unsigned int capacity)
 {
-    for(int i = 0;i<total_capacity;i++)
+    if(n == nullptr)
+    {
+        return;
+    }
+    for(unsigned int i = 0;i<capacity;i++)
     {
         
         if(n[i]!=nullptr)
@@ -218,200 +486,468 @@ void HashSet<ElementType>::delete_node(Nodes** n)
                 
                 n[i]=n[i]->next;
              
-                delete temp;
+                node_allocator.destroy(temp);
                
             }
         }
     }
-    delete[] hash;
-    hash = nullptr;
+    delete[] n;
 }
 ///--------------------------------------------------------------------------------------------
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashFunction hashFunction)
-    : hashFunction{hashFunction}
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::HashSet()
+    : HashSet{HashPolicy{}}
+{
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::HashSet(HashPolicy hashPolicy, bool incrementalResizing)
+    : HashSet{HashFunction{}, incrementalResizing}
+{
+    static_assert(std::is_invocable_v<const HashPolicy&, const ElementType&>,
+        "a HashSet with no hash function needs a HashPolicy that can hash its elements");
+
+    this->hashPolicy = hashPolicy;
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::HashSet(HashFunction hashFunction, bool incrementalResizing)
+    : hashFunction{hashFunction}, incremental{incrementalResizing}
 {
 
     total_capacity = DEFAULT_CAPACITY;
     hash = new Nodes*[DEFAULT_CAPACITY];
-    for(int i=0;i<total_capacity;i++)
+    for(unsigned int i=0;i<total_capacity;i++)
     {
         hash[i] = nullptr;
     }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::~HashSet() noexcept
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::~HashSet() noexcept
 {
-    delete_node(hash);
-}
-
-
-template <typename ElementType>
-HashSet<ElementType>::HashSet(const HashSet& s)
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>},hash(s.hash),total_capacity(s.total_capacity),total_size(s.total_size)
-{
-    total_capacity = s.total_capacity;
-    hash = new Nodes*[total_capacity];
-    for(int i=0;i<total_capacity;i++)
+    // A pool releases every node at once when it's destroyed, so the lists
+    // only need to be walked if the nodes have destructors to run.
+    if constexpr (NodeAllocator<Nodes>::releasesInBulk && std::is_trivially_destructible_v<Nodes>)
     {
-        hash[i]=nullptr;
+        delete[] hash;
+        delete[] old_hash;
     }
-    total_size = s.total_size;
-    for(int i = 0;i<total_capacity;i++)
+    else
     {
-        if(s.hash[i]!=nullptr)
-        {
-            hash[i]=copy_hash(s.hash[i]);
-        }
+        delete_node(hash, total_capacity);
+        delete_node(old_hash, old_capacity);
     }
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>::HashSet(HashSet&& s) noexcept
-    : hashFunction{impl_::HashSet__undefinedHashFunction<ElementType>},hash(nullptr),total_capacity(0),total_size(0)
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::HashSet(const HashSet& s)
+    : hashFunction{s.hashFunction},hashPolicy{s.hashPolicy},hash(nullptr),total_capacity(0),total_size(0),incremental(s.incremental)
+{
+    copy_from(s);
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>::HashSet(HashSet&& s) noexcept
+    : hashFunction{s.hashFunction},hashPolicy{s.hashPolicy},hash(nullptr),total_capacity(0),total_size(0)
 {
     swap(hash,s.hash);
     swap(total_capacity,s.total_capacity);
     swap(total_size,s.total_size);
+    swap(incremental,s.incremental);
+    swap(old_hash,s.old_hash);
+    swap(old_capacity,s.old_capacity);
+    swap(migrated,s.migrated);
+    node_allocator.swap(s.node_allocator);
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(const HashSet& s)
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>& HashSet<ElementType, HashPolicy, NodeAllocator>::operator=(const HashSet& s)
 {
     
     if (this != &s)
     {
         
-        delete_node(hash); 
+        delete_node(hash, total_capacity); 
+        delete_node(old_hash, old_capacity);
+        old_hash = nullptr;
         hashFunction = s.hashFunction;
-       
-        total_capacity = s.total_capacity;
-        hash = new Nodes*[total_capacity];
-        for(int i=0;i<total_capacity;i++)
-        {
-            hash[i]=nullptr;
-        }
-        total_size = s.total_size;
-        for(int i = 0;i<total_capacity;i++)
-        {
-            if(s.hash[i]!=nullptr)
-            {
-                hash[i]=copy_hash(s.hash[i]);
-            }
-        }
+        hashPolicy = s.hashPolicy;
+        incremental = s.incremental;
+        copy_from(s);
 
     }
     return *this;
 }
 
 
-template <typename ElementType>
-HashSet<ElementType>& HashSet<ElementType>::operator=(HashSet&& s) noexcept
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+HashSet<ElementType, HashPolicy, NodeAllocator>& HashSet<ElementType, HashPolicy, NodeAllocator>::operator=(HashSet&& s) noexcept
 {
+    swap(hashFunction,s.hashFunction);
+    swap(hashPolicy,s.hashPolicy);
     swap(hash,s.hash);
     swap(total_capacity,s.total_capacity);
     swap(total_size,s.total_size);
+    swap(incremental,s.incremental);
+    swap(old_hash,s.old_hash);
+    swap(old_capacity,s.old_capacity);
+    swap(migrated,s.migrated);
+    node_allocator.swap(s.node_allocator);
     return *this;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::isImplemented() const noexcept
 {
     return true;
 }
 
 
-template <typename ElementType>
-void HashSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::add(const ElementType& element)
 {
-    
-    add_node(element,hash);
-    
-    if(total_size/total_capacity >= 0.8)
+    unsigned int hashValue = hash_of(element);
+
+    migrate_buckets(MIGRATION_STEP);
+
+    if(find_node(element,hashValue))
     {
-        resize_hash(hash,element);
+        return;
     }
-    
-   
-}
-
 
-template <typename ElementType>
-bool HashSet<ElementType>::contains(const ElementType& element) const
-{
-    unsigned int index = static_cast<unsigned int>(hashFunction(element)) % total_capacity;
+    add_node(element,hashValue);
     
-    if(hash[index]!=nullptr)
+    if(total_size/total_capacity >= 0.8)
     {
-        Nodes* n = hash[index];
-        while(n!=nullptr)
+        if(incremental)
         {
-            if(n->key == element)
-            {
-                return true;
-            }
-            n = n -> next;
+            start_resize();
+        }
+        else
+        {
+            resize_hash();
         }
     }
+}
 
-    return false;
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::contains(const ElementType& element) const
+{
+    return containsKey(element);
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+template <typename Key>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::containsKey(const Key& element) const
+{
+    unsigned int hashValue = hash_of(element);
+
+    migrate_buckets(MIGRATION_STEP);
+
+    return find_node(element,hashValue);
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::size() const noexcept
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+unsigned int HashSet<ElementType, HashPolicy, NodeAllocator>::size() const noexcept
 {
     return total_size;
 }
 
 
-template <typename ElementType>
-unsigned int HashSet<ElementType>::elementsAtIndex(unsigned int index) const
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+unsigned int HashSet<ElementType, HashPolicy, NodeAllocator>::elementsAtIndex(unsigned int index) const
 {
     int result = 0;
-    if(index < total_capacity && hash[index]!=nullptr)
+    if(index < total_capacity)
     {
-        Nodes* temp = hash[index];
-        while(temp!=nullptr)
+        for(Nodes* temp = hash[index];temp!=nullptr;temp = temp -> next)
         {
             result += 1;
-            temp = temp -> next;
+        }
+
+        // Elements that haven't moved out of the old array yet still count
+        // toward the index they'll have once they do.
+        if(old_hash != nullptr && (index & (old_capacity - 1)) >= migrated)
+        {
+            for(Nodes* temp = old_hash[index & (old_capacity - 1)];temp!=nullptr;temp = temp -> next)
+            {
+                if((temp -> hashValue & (total_capacity - 1)) == index)
+                {
+                    result += 1;
+                }
+            }
         }
     }
     return result;
 }
 
 
-template <typename ElementType>
-bool HashSet<ElementType>::isElementAtIndex(const ElementType& element, unsigned int index) const
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::isElementAtIndex(const ElementType& element, unsigned int index) const
 {
-    Nodes* temp = hash[index];
-    
-    while(temp!=nullptr)
+    if(index >= total_capacity)
     {
-        try
+        return false;
+    }
+
+    for(Nodes* temp = hash[index];temp!=nullptr;temp = temp -> next)
+    {
+        if (temp->key == element)
+        {
+            return true;
+        }
+    }
+
+    if(old_hash != nullptr && (index & (old_capacity - 1)) >= migrated)
+    {
+        for(Nodes* temp = old_hash[index & (old_capacity - 1)];temp!=nullptr;temp = temp -> next)
         {
-            if (temp->key == element)
+            if ((temp -> hashValue & (total_capacity - 1)) == index && temp->key == element)
             {
                 return true;
             }
-            else
+        }
+    }
+    return false;
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+bool HashSet<ElementType, HashPolicy, NodeAllocator>::isResizing() const noexcept
+{
+    return old_hash != nullptr;
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::finishResizing()
+{
+    migrate_buckets(old_capacity);
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+double HashSet<ElementType, HashPolicy, NodeAllocator>::resizeProgress() const noexcept
+{
+    if(old_hash == nullptr)
+    {
+        return 1.0;
+    }
+    return static_cast<double>(migrated) / old_capacity;
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::save(const std::string& path) const
+{
+    static_assert(std::is_same_v<ElementType, std::string>, "only a HashSet of std::strings can be saved");
+
+    // The nodes are only ever saved from one array.
+    migrate_buckets(old_capacity);
+
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+
+    if(!out)
+    {
+        throw std::runtime_error{"couldn't open " + path + " to save a HashSet"};
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.endianCheck = FILE_ENDIAN_CHECK;
+    header.hashCheck = file_hash_check();
+    header.capacity = total_capacity;
+    header.count = size();
+
+    for(unsigned int i = 0;i<total_capacity;i++)
+    {
+        for(Nodes* temp = hash[i];temp!=nullptr;temp = temp -> next)
+        {
+            header.keyBytes += temp -> key.size();
+        }
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    std::vector<FileRecord> records;
+    std::string keys;
+    std::vector<const Nodes*> bucket;
+    records.reserve(FILE_BLOCK);
+
+    auto flush = [&]
+    {
+        out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(FileRecord));
+        out.write(keys.data(), keys.size());
+        records.clear();
+        keys.clear();
+    };
+
+    for(unsigned int i = 0;i<total_capacity;i++)
+    {
+        bucket.clear();
+
+        for(const Nodes* temp = hash[i];temp!=nullptr;temp = temp -> next)
+        {
+            bucket.push_back(temp);
+        }
+
+        for(auto n = bucket.rbegin();n!=bucket.rend();++n)
+        {
+            records.push_back(FileRecord{(*n) -> hashValue, static_cast<std::uint32_t>((*n) -> key.size())});
+            keys += (*n) -> key;
+
+            if(records.size() == FILE_BLOCK)
             {
-                temp = temp -> next;
+                flush();
             }
         }
-        catch(...)
+    }
+
+    flush();
+    out.close();
+
+    if(!out)
+    {
+        throw std::runtime_error{"couldn't save a HashSet to " + path};
+    }
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+void HashSet<ElementType, HashPolicy, NodeAllocator>::load(const std::string& path)
+{
+    static_assert(std::is_same_v<ElementType, std::string>, "only a HashSet of std::strings can be loaded");
+
+    std::ifstream in{path, std::ios::binary};
+    FileHeader header;
+
+    if(!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+    {
+        throw std::runtime_error{path + " isn't a saved HashSet"};
+    }
+    else if(std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0
+        || header.endianCheck != FILE_ENDIAN_CHECK
+        || header.capacity == 0 || (header.capacity & (header.capacity - 1)) != 0)
+    {
+        throw std::runtime_error{path + " isn't a saved HashSet"};
+    }
+    else if(header.hashCheck != file_hash_check())
+    {
+        throw std::runtime_error{path + " was saved with a different hash function"};
+    }
+
+    // Before anything is allocated, the header has to agree with the size
+    // of the file, and the capacity has to be one that a set of that many
+    // nodes could have grown to, so that a corrupt header can't ask for
+    // more memory than the file could possibly need.
+    in.seekg(0, std::ios::end);
+    std::streamoff fileBytes = in.tellg();
+    in.seekg(sizeof(header));
+
+    std::uint64_t nodeBytes = static_cast<std::uint64_t>(fileBytes) - sizeof(header);
+    std::uint64_t recordBytes = static_cast<std::uint64_t>(header.count) * sizeof(FileRecord);
+
+    if(!in || fileBytes < static_cast<std::streamoff>(sizeof(header))
+        || nodeBytes < recordBytes || nodeBytes - recordBytes != header.keyBytes
+        || header.capacity > std::max<std::uint64_t>(DEFAULT_CAPACITY, std::uint64_t{4} * header.count))
+    {
+        throw std::runtime_error{path + " is corrupt"};
+    }
+
+    // The nodes are loaded into a new HashSet, which only replaces this
+    // one once every node has been loaded.
+    HashSet loaded{hashFunction, incremental};
+    loaded.hashPolicy = hashPolicy;
+
+    delete[] loaded.hash;
+    loaded.hash = nullptr;
+    loaded.total_capacity = 0;
+    loaded.hash = new Nodes*[header.capacity];
+    loaded.total_capacity = header.capacity;
+
+    for(unsigned int i = 0;i<header.capacity;i++)
+    {
+        loaded.hash[i] = nullptr;
+    }
+
+    std::vector<FileRecord> records(FILE_BLOCK);
+    std::vector<char> characters;
+    std::string key;
+    std::uint64_t keyBytes = 0;
+
+    for(std::uint32_t done = 0;done<header.count;)
+    {
+        std::uint32_t block = std::min<std::uint32_t>(FILE_BLOCK, header.count - done);
+
+        if(!in.read(reinterpret_cast<char*>(records.data()), block * sizeof(FileRecord)))
+        {
+            throw std::runtime_error{path + " is truncated"};
+        }
+
+        std::size_t blockBytes = 0;
+
+        for(std::uint32_t i = 0;i<block;i++)
+        {
+            blockBytes += records[i].length;
+        }
+
+        keyBytes += blockBytes;
+
+        if(keyBytes > header.keyBytes)
+        {
+            throw std::runtime_error{path + " is corrupt"};
+        }
+
+        if(characters.size() < blockBytes)
+        {
+            characters.resize(blockBytes);
+        }
+
+        if(!in.read(characters.data(), blockBytes))
         {
-            throw;
+            throw std::runtime_error{path + " is truncated"};
         }
+
+        const char* next = characters.data();
+
+        for(std::uint32_t i = 0;i<block;i++)
+        {
+            key.assign(next, records[i].length);
+            next += records[i].length;
+
+            unsigned int index = records[i].hashValue & (loaded.total_capacity - 1);
+            loaded.hash[index] = loaded.node_allocator.create(key, records[i].hashValue, loaded.hash[index]);
+        }
+
+        done += block;
+        loaded.total_size += block;
     }
-    return false;
+
+    if(keyBytes != header.keyBytes)
+    {
+        throw std::runtime_error{path + " is corrupt"};
+    }
+
+    *this = std::move(loaded);
+}
+
+
+template <typename ElementType, typename HashPolicy, template <typename> typename NodeAllocator>
+std::uint32_t HashSet<ElementType, HashPolicy, NodeAllocator>::file_hash_check() const
+{
+    return hash_of(ElementType{"ICS 46 Spring 2018"});
 }
 
 
@@ -0,0 +1,279 @@
+// HashSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks for the hash-based Set implementations.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+
+
+namespace
+{
+    const unsigned int DICTIONARY_SIZES[] = {10000, 100000, 1000000};
+
+
+    // Loads the words into the set and then looks up every word along with
+    // the same number of words that aren't in it, reporting the average
+    // cost of each kind of operation.
+    template <typename SetType>
+    void measureSet(
+        const char* label, SetType& set,
+        const std::vector<std::string>& words,
+        const std::vector<std::string>& missing)
+    {
+        bench::Stopwatch watch;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        double buildMs = watch.elapsedMilliseconds();
+
+        watch.restart();
+        unsigned int hits = 0;
+
+        for (const std::string& word : words)
+        {
+            hits += set.contains(word);
+        }
+
+        double hitNs = bench::nanosPerOperation(watch, words.size());
+
+        watch.restart();
+
+        for (const std::string& word : missing)
+        {
+            hits += set.contains(word);
+        }
+
+        double missNs = bench::nanosPerOperation(watch, missing.size());
+        bench::doNotOptimize(hits);
+
+        std::printf("  %-12s %9zu words  build %9.2f ms  hit %7.1f ns  miss %7.1f ns\n",
+            label, words.size(), buildMs, hitNs, missNs);
+    }
+}
+
+
+BENCHMARK(HashSet, chainedVersusFlat)
+{
+    for (unsigned int size : DICTIONARY_SIZES)
+    {
+        // The missing words are drawn from the same distribution as the
+        // dictionary, but are filtered so that none of them are in it.
+        std::vector<std::string> all = bench::makeWords(size * 2, 46);
+        std::vector<std::string> words{all.begin(), all.begin() + size};
+        std::vector<std::string> missing{all.begin() + size, all.end()};
+
+        {
+            HashSet<std::string> chained{bench::stringHash};
+            measureSet("chained", chained, words, missing);
+        }
+
+        {
+            FlatHashSet<std::string> flat{bench::stringHash};
+            measureSet("flat", flat, words, missing);
+        }
+    }
+}
+
+
+BENCHMARK(HashSet, dictionaryLoad)
+{
+    // Loading a dictionary crosses the resizing threshold about log2(n)
+    // times; this reports how long the whole load takes, how many
+    // allocations it makes per word, and how much of the time was spent
+    // in the add() calls that triggered a resize.
+    for (unsigned int size : {100000u, 500000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 2018);
+
+        HashSet<std::string> set{bench::stringHash};
+        std::size_t allocationsBefore = bench::allocationCount();
+        double resizeMs = 0.0;
+        unsigned int resizes = 0;
+        bench::Stopwatch total;
+
+        for (unsigned int i = 0; i < words.size(); ++i)
+        {
+            // The capacity doubles from DEFAULT_CAPACITY whenever the size
+            // reaches 80% of it, so we can tell which add() calls will
+            // resize.
+            bool resizing = false;
+
+            for (unsigned int capacity = HashSet<std::string>::DEFAULT_CAPACITY;
+                 capacity <= 2 * words.size(); capacity *= 2)
+            {
+                resizing = resizing || (i + 1) == (capacity * 4 + 4) / 5;
+            }
+
+            if (resizing)
+            {
+                bench::Stopwatch watch;
+                set.add(words[i]);
+                resizeMs += watch.elapsedMilliseconds();
+                resizes++;
+            }
+            else
+            {
+                set.add(words[i]);
+            }
+        }
+
+        double totalMs = total.elapsedMilliseconds();
+        std::size_t allocations = bench::allocationCount() - allocationsBefore;
+
+        std::printf("  %7u words  load %8.2f ms  resizes %2u (%8.2f ms)  allocations %9zu (%.2f/word)\n",
+            size, totalMs, resizes, resizeMs, allocations,
+            static_cast<double>(allocations) / size);
+    }
+}
+
+BENCHMARK(HashSet, addTailLatency)
+{
+    // Times every add() individually while loading a large dictionary,
+    // with resizing done all at once and incrementally, and reports the
+    // slowest calls.  The median is dominated by timer overhead; it's the
+    // tail that matters here.
+    const unsigned int size = 1000000;
+    std::vector<std::string> words = bench::makeWords(size, 1234);
+    std::vector<double> latencies(size);
+
+    for (bool incremental : {false, true})
+    {
+        HashSet<std::string> set{bench::stringHash, incremental};
+        unsigned int addsDuringResize = 0;
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            bench::Stopwatch watch;
+            set.add(words[i]);
+            latencies[i] = watch.elapsedNanoseconds();
+
+            if (incremental && set.isResizing())
+            {
+                addsDuringResize++;
+            }
+        }
+
+        std::vector<double> sorted = latencies;
+        std::sort(sorted.begin(), sorted.end());
+
+        std::printf("  %-11s  p50 %8.0f ns  p99.99 %10.0f ns  max %12.0f ns  adds during resize %u\n",
+            incremental ? "incremental" : "all at once",
+            sorted[size / 2], sorted[size - size / 10000], sorted[size - 1], addsDuringResize);
+    }
+}
+
+BENCHMARK(HashSet, hashPolicyVersusFunction)
+{
+    // Compares the per-lookup cost of hashing through a std::function with
+    // that of an inlinable hash policy.  The middle row uses the same hash
+    // as the policy, but calls it through a std::function, which separates
+    // the cost of the indirect call from the quality of the hash.  The
+    // dictionary is small enough to stay in cache, so that the hashing
+    // isn't hidden behind cache misses.
+    const unsigned int size = 10000;
+    const unsigned int rounds = 50;
+    std::vector<std::string> words = bench::makeWords(size, 7);
+
+    HashSet<std::string> fnvFunction{bench::stringHash};
+    HashSet<std::string> wyFunction{[](const std::string& s) { return DefaultHash<std::string>{}(s); }};
+    HashSet<std::string> wyPolicy;
+
+    for (const std::string& word : words)
+    {
+        fnvFunction.add(word);
+        wyFunction.add(word);
+        wyPolicy.add(word);
+    }
+
+    auto measure = [&](const char* label, const HashSet<std::string>& set)
+    {
+        bench::Stopwatch watch;
+        unsigned int hits = 0;
+
+        for (unsigned int round = 0; round < rounds; ++round)
+        {
+            for (const std::string& word : words)
+            {
+                hits += set.contains(word);
+            }
+        }
+
+        bench::doNotOptimize(hits);
+        std::printf("  %-12s  %6.1f ns/lookup\n", label,
+            bench::nanosPerOperation(watch, rounds * words.size()));
+    };
+
+    measure("fnv function", fnvFunction);
+    measure("wy function", wyFunction);
+    measure("wy policy", wyPolicy);
+}
+
+
+BENCHMARK(HashSet, restartFromSavedSet)
+{
+    // Restarting used to mean reading the word list and adding every word
+    // again; a saved set is read back without hashing or resizing.
+    std::string listPath = "/tmp/HashSet_Benchmarks.txt";
+    std::string savedPath = "/tmp/HashSet_Benchmarks.bin";
+
+    for (unsigned int size : DICTIONARY_SIZES)
+    {
+        std::vector<std::string> words = bench::makeWords(size, 2024);
+
+        {
+            std::ofstream out{listPath};
+
+            for (const std::string& word : words)
+            {
+                out << word << '\n';
+            }
+        }
+
+        bench::Stopwatch watch;
+        HashSet<std::string> rebuilt;
+
+        {
+            std::ifstream in{listPath};
+            std::string word;
+
+            while (in >> word)
+            {
+                rebuilt.add(word);
+            }
+        }
+
+        double rebuildMs = watch.elapsedMilliseconds();
+
+        watch.restart();
+        rebuilt.save(savedPath);
+        double saveMs = watch.elapsedMilliseconds();
+
+        std::size_t allocationsBefore = bench::allocationCount();
+        watch.restart();
+
+        HashSet<std::string> loaded;
+        loaded.load(savedPath);
+
+        double loadMs = watch.elapsedMilliseconds();
+        std::size_t allocations = bench::allocationCount() - allocationsBefore;
+        bench::doNotOptimize(loaded.size());
+
+        std::printf("  %8u words  rebuild from list %8.2f ms  save %7.2f ms  load %7.2f ms (%.2f allocations/word)\n",
+            size, rebuildMs, saveMs, loadMs, static_cast<double>(allocations) / size);
+    }
+
+    std::remove(listPath.c_str());
+    std::remove(savedPath.c_str());
+}
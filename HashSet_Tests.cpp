@@ -0,0 +1,468 @@
+// HashSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for HashSet beyond the provided sanity checks, focused on
+// how elements are placed as the table resizes.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+#include "HashSet.hpp"
+
+
+namespace
+{
+    unsigned int identityHash(const int& i)
+    {
+        return static_cast<unsigned int>(i);
+    }
+
+
+    unsigned int countingHashCalls = 0;
+
+    unsigned int countingHash(const int& i)
+    {
+        countingHashCalls++;
+        return static_cast<unsigned int>(i);
+    }
+}
+
+
+TEST(HashSet_Tests, elementsMoveToTheirNewIndexWhenResizing)
+{
+    HashSet<int> s{identityHash};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(100, s.size());
+
+    // 100 elements at a maximum load factor of 0.8 require a capacity of
+    // 128, which is large enough that each element is alone at its index.
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+        EXPECT_EQ(1, s.elementsAtIndex(i));
+        EXPECT_TRUE(s.isElementAtIndex(i, i));
+    }
+}
+
+
+TEST(HashSet_Tests, resizingDoesNotRehashElements)
+{
+    countingHashCalls = 0;
+    HashSet<int> s{countingHash};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(1000, countingHashCalls);
+}
+
+
+TEST(HashSet_Tests, copiesHashTheSameWayAsTheOriginal)
+{
+    HashSet<std::string> s1{[](const std::string& s) { return static_cast<unsigned int>(s.size()); }};
+    s1.add("A");
+    s1.add("BB");
+
+    HashSet<std::string> s2{s1};
+    s2.add("CCC");
+
+    EXPECT_TRUE(s2.contains("A"));
+    EXPECT_TRUE(s2.contains("BB"));
+    EXPECT_TRUE(s2.contains("CCC"));
+    EXPECT_TRUE(s2.isElementAtIndex("CCC", 3));
+    EXPECT_FALSE(s1.contains("CCC"));
+}
+
+
+TEST(HashSet_Tests, addingDuplicatesHasNoEffect)
+{
+    HashSet<int> s{identityHash};
+    s.add(3);
+    s.add(3);
+
+    EXPECT_EQ(1, s.size());
+    EXPECT_EQ(1, s.elementsAtIndex(3));
+}
+
+
+TEST(HashSet_Tests, incrementalResizeSpreadsOutTheWork)
+{
+    HashSet<int> s{identityHash, true};
+
+    for (int i = 0; i < 13; ++i)
+    {
+        s.add(i);
+    }
+
+    // The thirteenth element crossed the threshold, so the array is now twice
+    // as large, but none of the old array's cells have been moved yet.
+    EXPECT_TRUE(s.isResizing());
+    EXPECT_DOUBLE_EQ(0.0, s.resizeProgress());
+
+    // Elements that haven't moved yet are still found, and are reported
+    // at the index they'll have in the new array.
+    for (int i = 0; i < 13; ++i)
+    {
+        EXPECT_TRUE(s.isElementAtIndex(i, i));
+        EXPECT_EQ(1, s.elementsAtIndex(i));
+    }
+
+    // Each call to contains() moves MIGRATION_STEP cells.
+    EXPECT_TRUE(s.contains(0));
+    EXPECT_TRUE(s.isResizing());
+    EXPECT_DOUBLE_EQ(0.5, s.resizeProgress());
+
+    EXPECT_FALSE(s.contains(100));
+    EXPECT_FALSE(s.isResizing());
+    EXPECT_DOUBLE_EQ(1.0, s.resizeProgress());
+
+    for (int i = 0; i < 13; ++i)
+    {
+        EXPECT_TRUE(s.contains(i));
+        EXPECT_TRUE(s.isElementAtIndex(i, i));
+    }
+}
+
+
+TEST(HashSet_Tests, finishResizingMovesEverythingAtOnce)
+{
+    HashSet<int> s{identityHash, true};
+
+    for (int i = 0; i < 13; ++i)
+    {
+        s.add(i);
+    }
+
+    EXPECT_TRUE(s.isResizing());
+    s.finishResizing();
+    EXPECT_FALSE(s.isResizing());
+    s.finishResizing();
+
+    for (int i = 0; i < 13; ++i)
+    {
+        EXPECT_TRUE(s.isElementAtIndex(i, i));
+    }
+}
+
+
+TEST(HashSet_Tests, incrementalResizeKeepsEveryElement)
+{
+    HashSet<std::string> s{[](const std::string& str)
+    {
+        return static_cast<unsigned int>(std::hash<std::string>{}(str));
+    }, true};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        s.add(std::to_string(i));
+        s.add(std::to_string(i / 2));
+    }
+
+    EXPECT_EQ(5000, s.size());
+
+    HashSet<std::string> copy{s};
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        EXPECT_TRUE(s.contains(std::to_string(i)));
+        EXPECT_TRUE(copy.contains(std::to_string(i)));
+    }
+
+    EXPECT_FALSE(s.contains("-1"));
+    EXPECT_FALSE(s.isResizing());
+}
+
+TEST(HashSet_Tests, defaultHashPolicyNeedsNoHashFunction)
+{
+    HashSet<std::string> s;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    EXPECT_EQ(1000, s.size());
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        EXPECT_TRUE(s.contains(word));
+        EXPECT_TRUE(s.isElementAtIndex(word, DefaultHash<std::string>{}(word) % 2048));
+    }
+
+    EXPECT_FALSE(s.contains("WORD1000"));
+}
+
+
+namespace
+{
+    struct ModuloFourHash
+    {
+        unsigned int operator()(const int& i) const
+        {
+            return static_cast<unsigned int>(i % 4);
+        }
+    };
+}
+
+
+TEST(HashSet_Tests, customHashPolicyDecidesTheIndex)
+{
+    HashSet<int, ModuloFourHash> s;
+    s.add(1);
+    s.add(5);
+    s.add(9);
+
+    EXPECT_EQ(3, s.elementsAtIndex(1));
+    EXPECT_TRUE(s.isElementAtIndex(9, 1));
+
+    HashSet<int, ModuloFourHash> moved{std::move(s)};
+    EXPECT_TRUE(moved.contains(5));
+    moved.add(13);
+    EXPECT_EQ(4, moved.elementsAtIndex(1));
+}
+
+
+namespace
+{
+    struct Point
+    {
+        int x;
+        int y;
+    };
+
+
+    bool operator==(const Point& a, const Point& b)
+    {
+        return a.x == b.x && a.y == b.y;
+    }
+
+
+    unsigned int pointHash(const Point& p)
+    {
+        return static_cast<unsigned int>(p.x * 31 + p.y);
+    }
+}
+
+
+TEST(HashSet_Tests, hashFunctionAloneCanHashTypesWithoutStdHash)
+{
+    HashSet<Point> s{pointHash};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        s.add(Point{i, -i});
+    }
+
+    EXPECT_EQ(100, s.size());
+    EXPECT_TRUE(s.contains(Point{42, -42}));
+    EXPECT_FALSE(s.contains(Point{42, 42}));
+
+    HashSet<Point> copy{s};
+    EXPECT_TRUE(copy.contains(Point{99, -99}));
+}
+
+
+TEST(HashSet_Tests, canLookUpStringsByView)
+{
+    HashSet<std::string> policy;
+    HashSet<std::string> function{[](const std::string& s) { return static_cast<unsigned int>(s.size()); }};
+
+    for (HashSet<std::string>* s : {&policy, &function})
+    {
+        s->add("HELLO");
+        s->add("THERE");
+
+        std::string text = "HELLOTHERE";
+        std::string_view view = text;
+        const StringViewLookup& lookup = *s;
+
+        EXPECT_TRUE(lookup.containsView(view.substr(0, 5)));
+        EXPECT_TRUE(lookup.containsView(view.substr(5)));
+        EXPECT_FALSE(lookup.containsView(view.substr(1, 5)));
+        EXPECT_TRUE(s->containsKey(view.substr(5)));
+    }
+}
+
+
+TEST(HashSet_Tests, savedSetsLoadWithTheSameLayout)
+{
+    HashSet<std::string> original;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        original.add("WORD" + std::to_string(i));
+    }
+
+    original.add("");
+
+    std::string path = ::testing::TempDir() + "HashSet_Tests_saved.bin";
+    original.save(path);
+
+    HashSet<std::string> loaded;
+    loaded.add("GONE");
+    loaded.load(path);
+
+    EXPECT_EQ(original.size(), loaded.size());
+    EXPECT_FALSE(loaded.contains("GONE"));
+    EXPECT_TRUE(loaded.contains(""));
+
+    for (unsigned int i = 0; i < 8192; ++i)
+    {
+        ASSERT_EQ(original.elementsAtIndex(i), loaded.elementsAtIndex(i)) << i;
+    }
+
+    EXPECT_EQ(0, loaded.elementsAtIndex(8192));
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        EXPECT_TRUE(loaded.contains(word)) << word;
+    }
+
+    // The loaded set grows as usual from there.
+    for (int i = 3000; i < 7000; ++i)
+    {
+        loaded.add("WORD" + std::to_string(i));
+    }
+
+    EXPECT_EQ(7001, loaded.size());
+    EXPECT_TRUE(loaded.contains("WORD1234"));
+    EXPECT_TRUE(loaded.contains("WORD6999"));
+
+    std::remove(path.c_str());
+}
+
+
+TEST(HashSet_Tests, savingFinishesAnIncrementalResize)
+{
+    HashSet<std::string> original{DefaultHash<std::string>{}, true};
+
+    for (int i = 0; i < 13; ++i)
+    {
+        original.add(std::to_string(i));
+    }
+
+    ASSERT_TRUE(original.isResizing());
+
+    std::string path = ::testing::TempDir() + "HashSet_Tests_resizing.bin";
+    original.save(path);
+
+    HashSet<std::string> loaded;
+    loaded.load(path);
+
+    EXPECT_EQ(13, loaded.size());
+
+    for (int i = 0; i < 13; ++i)
+    {
+        EXPECT_TRUE(loaded.contains(std::to_string(i)));
+    }
+
+    std::remove(path.c_str());
+}
+
+
+TEST(HashSet_Tests, loadingRejectsOtherHashFunctionsAndBadFiles)
+{
+    HashSet<std::string> original;
+    original.add("APPLE");
+    original.add("PEAR");
+
+    std::string path = ::testing::TempDir() + "HashSet_Tests_rejected.bin";
+    original.save(path);
+
+    HashSet<std::string> other{[](const std::string& s) { return static_cast<unsigned int>(s.size()); }};
+    other.add("PLUM");
+    EXPECT_THROW(other.load(path), std::runtime_error);
+    EXPECT_EQ(1, other.size());
+    EXPECT_TRUE(other.contains("PLUM"));
+
+    std::string contents;
+
+    {
+        std::ifstream in{path, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+    }
+
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(contents.data(), contents.size() - 1);
+    }
+
+    HashSet<std::string> truncated;
+    truncated.add("PLUM");
+    EXPECT_THROW(truncated.load(path), std::runtime_error);
+    EXPECT_EQ(1, truncated.size());
+
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out << "APPLE\nPEAR\nPLUM\nKIWI\nFIG\nDATE\nLIME\nLEMON\n";
+    }
+
+    EXPECT_THROW(truncated.load(path), std::runtime_error);
+    EXPECT_THROW(truncated.load(path + ".missing"), std::runtime_error);
+
+    std::remove(path.c_str());
+}
+
+
+TEST(HashSet_Tests, loadingRejectsHeadersThatDisagreeWithTheFile)
+{
+    HashSet<std::string> original;
+    original.add("APPLE");
+    original.add("PEAR");
+
+    std::string path = ::testing::TempDir() + "HashSet_Tests_header.bin";
+    original.save(path);
+
+    std::string contents;
+
+    {
+        std::ifstream in{path, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+    }
+
+    // The header's capacity, count, and key length follow its 16 bytes of
+    // magic number, byte order, and hash check.
+    auto saveWithHeaderField = [&](std::size_t offset, auto value)
+    {
+        std::string changed = contents;
+        std::memcpy(&changed[offset], &value, sizeof(value));
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(changed.data(), changed.size());
+    };
+
+    HashSet<std::string> loaded;
+    loaded.add("PLUM");
+
+    saveWithHeaderField(16, std::uint32_t{0x80000000});
+    EXPECT_THROW(loaded.load(path), std::runtime_error);
+
+    saveWithHeaderField(20, std::uint32_t{0x10000000});
+    EXPECT_THROW(loaded.load(path), std::runtime_error);
+
+    saveWithHeaderField(24, std::uint64_t{0x100000000});
+    EXPECT_THROW(loaded.load(path), std::runtime_error);
+
+    saveWithHeaderField(24, ~std::uint64_t{0});
+    EXPECT_THROW(loaded.load(path), std::runtime_error);
+
+    EXPECT_EQ(1, loaded.size());
+    EXPECT_TRUE(loaded.contains("PLUM"));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,154 @@
+// Hashing.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Hash policies that can be handed to HashSet as a template argument.  A
+// hash policy is any type that can be default-constructed and called with
+// a reference to a const element, returning an unsigned int.  Because the
+// policy's type is known at compile time, its call can be inlined into
+// every lookup, which isn't possible with a std::function.
+//
+// DefaultHash is the policy HashSet uses unless told otherwise.  For
+// strings, it's a fast multiply-and-fold hash in the style of wyhash,
+// which consumes eight bytes at a time; for other types, it mixes the
+// bits of std::hash so that the low bits (which HashSet uses to choose an
+// index) depend on all of the others.  For a type with no std::hash, it
+// can't be called at all, so such a type can only be hashed by a function
+// given to HashSet's constructor.
+
+#ifndef HASHING_HPP
+#define HASHING_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+
+
+namespace hashing
+{
+    // mum() multiplies two 64-bit values into a 128-bit product and folds
+    // the two halves of it together.
+    inline std::uint64_t mum(std::uint64_t a, std::uint64_t b) noexcept
+    {
+        __uint128_t product = static_cast<__uint128_t>(a) * b;
+        return static_cast<std::uint64_t>(product)
+            ^ static_cast<std::uint64_t>(product >> 64);
+    }
+
+
+    inline std::uint64_t read64(const unsigned char* p) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    inline std::uint64_t read32(const unsigned char* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+
+    // hashBytes() hashes an arbitrary sequence of bytes.  Inputs of up to
+    // sixteen bytes -- which is nearly every word in a dictionary -- are
+    // read with at most four overlapping loads and no loop.
+    inline std::uint64_t hashBytes(const char* data, std::size_t length, std::uint64_t seed = 0) noexcept
+    {
+        constexpr std::uint64_t s0 = 0xa0761d6478bd642full;
+        constexpr std::uint64_t s1 = 0xe7037ed1a0b428dbull;
+
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+        seed ^= mum(seed ^ s0, s1);
+
+        std::uint64_t a;
+        std::uint64_t b;
+
+        if (length <= 16)
+        {
+            if (length >= 4)
+            {
+                std::size_t middle = (length >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + middle);
+                b = (read32(p + length - 4) << 32) | read32(p + length - 4 - middle);
+            }
+            else if (length > 0)
+            {
+                a = (static_cast<std::uint64_t>(p[0]) << 16)
+                    | (static_cast<std::uint64_t>(p[length >> 1]) << 8)
+                    | p[length - 1];
+                b = 0;
+            }
+            else
+            {
+                a = 0;
+                b = 0;
+            }
+        }
+        else
+        {
+            std::size_t remaining = length;
+
+            while (remaining > 16)
+            {
+                seed = mum(read64(p) ^ s1, read64(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+
+            a = read64(p + remaining - 16);
+            b = read64(p + remaining - 8);
+        }
+
+        return mum(s1 ^ length, mum(a ^ s1, b ^ seed));
+    }
+
+
+    // mix64() spreads the entropy of every bit of a 64-bit value into all
+    // of the others.  (This is the finalizer from SplitMix64.)
+    inline std::uint64_t mix64(std::uint64_t x) noexcept
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+
+
+template <typename ElementType>
+struct DefaultHash
+{
+    template <typename Element = ElementType,
+        typename = std::enable_if_t<std::is_default_constructible_v<std::hash<Element>>>>
+    unsigned int operator()(const ElementType& element) const noexcept
+    {
+        return static_cast<unsigned int>(
+            hashing::mix64(static_cast<std::uint64_t>(std::hash<ElementType>{}(element))));
+    }
+};
+
+
+template <>
+struct DefaultHash<std::string>
+{
+    unsigned int operator()(std::string_view element) const noexcept
+    {
+        return static_cast<unsigned int>(hashing::hashBytes(element.data(), element.size()));
+    }
+};
+
+
+
+#endif // HASHING_HPP
+
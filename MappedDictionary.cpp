@@ -0,0 +1,304 @@
+// MappedDictionary.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Hashing.hpp"
+#include "MappedDictionary.hpp"
+
+
+namespace
+{
+    std::runtime_error imageError(const std::string& path, const std::string& reason)
+    {
+        return std::runtime_error{"dictionary image " + path + ": " + reason};
+    }
+}
+
+
+MappedDictionary::MappedDictionary(const std::string& path)
+    : image{nullptr}, bytes{0}, count{0}, bucketMask{0},
+      buckets{nullptr}, entries{nullptr}, characters{nullptr}, characterCount{0}
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw imageError(path, std::strerror(errno));
+    }
+
+    struct stat status;
+
+    if (::fstat(fd, &status) != 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw imageError(path, std::strerror(error));
+    }
+
+    if (static_cast<std::size_t>(status.st_size) < sizeof(Header))
+    {
+        ::close(fd);
+        throw imageError(path, "too short to be an image");
+    }
+
+    bytes = static_cast<std::size_t>(status.st_size);
+    image = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    int error = errno;
+
+    // The mapping keeps the file open on its own.
+    ::close(fd);
+
+    if (image == MAP_FAILED)
+    {
+        image = nullptr;
+        throw imageError(path, std::strerror(error));
+    }
+
+    // Only the header is checked, so that opening an image takes the same
+    // time no matter how large it is; lookups guard against the rest of
+    // the image being malformed.
+    const Header* header = static_cast<const Header*>(image);
+    const char* reason = nullptr;
+
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        reason = "not an image";
+    }
+    else if (header->byteOrder != ENDIAN_CHECK)
+    {
+        reason = "written on a machine with a different byte order";
+    }
+    else if (header->hashCheck != hash_check())
+    {
+        reason = "written with a different hash function";
+    }
+    else if (header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) != 0
+        || image_size(header->count, header->bucketCount, header->characterCount) != bytes)
+    {
+        reason = "malformed header";
+    }
+
+    if (reason != nullptr)
+    {
+        ::munmap(image, bytes);
+        image = nullptr;
+        throw imageError(path, reason);
+    }
+
+    const char* base = static_cast<const char*>(image);
+    count = header->count;
+    bucketMask = header->bucketCount - 1;
+    buckets = reinterpret_cast<const std::uint32_t*>(base + sizeof(Header));
+    entries = reinterpret_cast<const Entry*>(buckets + header->bucketCount + 1);
+    characters = reinterpret_cast<const char*>(entries + count);
+    characterCount = header->characterCount;
+}
+
+
+MappedDictionary::~MappedDictionary() noexcept
+{
+    if (image != nullptr)
+    {
+        ::munmap(image, bytes);
+    }
+}
+
+
+MappedDictionary::MappedDictionary(MappedDictionary&& d) noexcept
+    : image{std::exchange(d.image, nullptr)}, bytes{std::exchange(d.bytes, 0)},
+      count{std::exchange(d.count, 0)}, bucketMask{std::exchange(d.bucketMask, 0)},
+      buckets{std::exchange(d.buckets, nullptr)}, entries{std::exchange(d.entries, nullptr)},
+      characters{std::exchange(d.characters, nullptr)}, characterCount{std::exchange(d.characterCount, 0)}
+{
+}
+
+
+MappedDictionary& MappedDictionary::operator=(MappedDictionary&& d) noexcept
+{
+    std::swap(image, d.image);
+    std::swap(bytes, d.bytes);
+    std::swap(count, d.count);
+    std::swap(bucketMask, d.bucketMask);
+    std::swap(buckets, d.buckets);
+    std::swap(entries, d.entries);
+    std::swap(characters, d.characters);
+    std::swap(characterCount, d.characterCount);
+    return *this;
+}
+
+
+bool MappedDictionary::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void MappedDictionary::add(const std::string&)
+{
+    throw std::logic_error{"MappedDictionary can't be added to"};
+}
+
+
+bool MappedDictionary::contains(const std::string& element) const
+{
+    return containsKey(element);
+}
+
+
+bool MappedDictionary::containsKey(std::string_view key) const
+{
+    if (buckets == nullptr)
+    {
+        return false;
+    }
+
+    std::uint32_t hash = DefaultHash<std::string>{}(key);
+    std::uint32_t bucket = hash & bucketMask;
+    std::uint32_t last = std::min(buckets[bucket + 1], count);
+
+    for (std::uint32_t i = buckets[bucket]; i < last; ++i)
+    {
+        const Entry& entry = entries[i];
+
+        if (entry.hash == hash && entry.length == key.size()
+            && entry.offset <= characterCount && entry.length <= characterCount - entry.offset
+            && std::memcmp(characters + entry.offset, key.data(), key.size()) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+unsigned int MappedDictionary::size() const noexcept
+{
+    return count;
+}
+
+
+std::size_t MappedDictionary::imageBytes() const noexcept
+{
+    return bytes;
+}
+
+
+void MappedDictionary::writeImage(const std::string& path, std::vector<std::string> words)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::size_t totalCharacters = 0;
+
+    for (const std::string& word : words)
+    {
+        totalCharacters += word.size();
+    }
+
+    if (words.size() > UINT32_MAX / 2 || totalCharacters > UINT32_MAX)
+    {
+        throw imageError(path, "too many words for an image");
+    }
+
+    std::uint32_t wordCount = static_cast<std::uint32_t>(words.size());
+    std::uint32_t bucketCount = 1;
+
+    while (bucketCount < wordCount)
+    {
+        bucketCount *= 2;
+    }
+
+    // The entries are placed in order of bucket by counting how many
+    // words land in each bucket, then turning the counts into starting
+    // indexes.  Within a bucket, the words stay in sorted order, so the
+    // same words always produce the same image.
+    std::vector<std::uint32_t> hashes(wordCount);
+    std::vector<std::uint32_t> bucketStarts(bucketCount + 1, 0);
+
+    for (std::uint32_t i = 0; i < wordCount; ++i)
+    {
+        hashes[i] = DefaultHash<std::string>{}(words[i]);
+        bucketStarts[(hashes[i] & (bucketCount - 1)) + 1]++;
+    }
+
+    for (std::uint32_t b = 0; b < bucketCount; ++b)
+    {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    std::vector<Entry> placed(wordCount);
+    std::vector<std::uint32_t> nextInBucket(bucketStarts.begin(), bucketStarts.end() - 1);
+    std::string allCharacters;
+    allCharacters.reserve(totalCharacters);
+
+    for (std::uint32_t i = 0; i < wordCount; ++i)
+    {
+        std::uint32_t at = nextInBucket[hashes[i] & (bucketCount - 1)]++;
+        placed[at] = Entry{hashes[i], static_cast<std::uint32_t>(words[i].size()),
+            static_cast<std::uint32_t>(allCharacters.size())};
+        allCharacters += words[i];
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = ENDIAN_CHECK;
+    header.hashCheck = hash_check();
+    header.count = wordCount;
+    header.bucketCount = bucketCount;
+    header.characterCount = static_cast<std::uint32_t>(totalCharacters);
+
+    std::string temporaryPath = path + ".tmp";
+
+    {
+        std::ofstream out{temporaryPath, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(bucketStarts.data()), bucketStarts.size() * sizeof(std::uint32_t));
+        out.write(reinterpret_cast<const char*>(placed.data()), placed.size() * sizeof(Entry));
+        out.write(allCharacters.data(), allCharacters.size());
+        out.close();
+
+        if (!out)
+        {
+            std::remove(temporaryPath.c_str());
+            throw imageError(path, "couldn't be written");
+        }
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        int error = errno;
+        std::remove(temporaryPath.c_str());
+        throw imageError(path, std::strerror(error));
+    }
+}
+
+
+std::uint32_t MappedDictionary::hash_check() noexcept
+{
+    // Hashing a fixed string tells whether the build that wrote an image
+    // hashes words the same way as this one.
+    return DefaultHash<std::string>{}(std::string_view{"ICS 46 Spring 2018"});
+}
+
+
+std::size_t MappedDictionary::image_size(
+    std::uint32_t count, std::uint32_t bucketCount, std::uint32_t characterCount) noexcept
+{
+    return sizeof(Header)
+        + (static_cast<std::size_t>(bucketCount) + 1) * sizeof(std::uint32_t)
+        + static_cast<std::size_t>(count) * sizeof(Entry)
+        + characterCount;
+}
@@ -0,0 +1,152 @@
+// MappedDictionary.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A MappedDictionary is a read-only Set of strings that's searched in
+// place in a dictionary "image" file, which is mapped into memory rather
+// than read.  Building any of the other Sets means reading every word and
+// adding it, in every process that needs the dictionary; opening a
+// MappedDictionary only reads the image's header, no matter how many words
+// it has, and the rest of the image is brought into memory a page at a
+// time as lookups touch it.  Every process that maps the same image shares
+// the same pages of the operating system's cache, so once one process has
+// read a page, the others find it already there.
+//
+// An image is written by writeImage() (or by the makeimage tool, which
+// writes one from a word list), e.g.,
+//
+//     MappedDictionary::writeImage("words.img", words);
+//     ...
+//     MappedDictionary dictionary{"words.img"};
+//     WordChecker checker{dictionary};
+//
+// An image is a hash table laid out as four consecutive arrays:
+//
+//   * A Header, which identifies the file as an image and gives the sizes
+//     of the other three arrays.
+//   * The buckets, of which there are a power of two.  Bucket b holds the
+//     index of the first entry whose hash ends with b's bits, so bucket
+//     b's entries are the ones from buckets[b] up to buckets[b + 1].
+//   * The entries, one per word, each giving the word's full hash, its
+//     length, and where its characters begin.
+//   * The characters of all the words, one after another.
+//
+// So a lookup hashes the key, reads two adjacent buckets, and compares the
+// key against the (usually one or two) entries between them, comparing
+// the stored hashes first.
+//
+// Images are written in the byte order and with the hash function of the
+// machine that wrote them; the header records both, so an image written
+// by an incompatible build is rejected when it's opened, rather than
+// silently finding nothing.
+//
+// Opening an image that's missing or malformed throws a std::runtime_error.
+// Since a MappedDictionary can't be changed, add() throws a
+// std::logic_error.  writeImage() replaces an existing image by renaming
+// a new file over it, so processes that already have the old image mapped
+// keep searching it undisturbed.
+
+#ifndef MAPPEDDICTIONARY_HPP
+#define MAPPEDDICTIONARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+
+class MappedDictionary : public Set<std::string>,
+    public TransparentLookup<std::string, MappedDictionary>
+{
+public:
+    // Maps the image at the given path.
+    explicit MappedDictionary(const std::string& path);
+
+    // Unmaps the image.
+    virtual ~MappedDictionary() noexcept;
+
+    MappedDictionary(const MappedDictionary&) = delete;
+    MappedDictionary& operator=(const MappedDictionary&) = delete;
+
+    // Initializes a new MappedDictionary that takes over the image mapped
+    // by an expiring one.
+    MappedDictionary(MappedDictionary&& d) noexcept;
+
+    // Swaps images with an expiring MappedDictionary.
+    MappedDictionary& operator=(MappedDictionary&& d) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() always throws a std::logic_error, because a MappedDictionary
+    // can't be changed.
+    virtual void add(const std::string& element) override;
+
+
+    // contains() returns true if the given word is in the image, false
+    // otherwise.  This function runs in O(1) time on average.
+    virtual bool contains(const std::string& element) const override;
+
+
+    // containsKey() is like contains(), but accepts a std::string_view.
+    bool containsKey(std::string_view key) const;
+
+
+    // size() returns the number of words in the image.
+    virtual unsigned int size() const noexcept override;
+
+
+    // imageBytes() returns the size of the mapped image, in bytes.
+    std::size_t imageBytes() const noexcept;
+
+
+    // writeImage() writes an image containing the given words (ignoring
+    // any duplicates) to the given path, throwing a std::runtime_error if
+    // it can't.
+    static void writeImage(const std::string& path, std::vector<std::string> words);
+
+
+private:
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t byteOrder;
+        std::uint32_t hashCheck;
+        std::uint32_t count;
+        std::uint32_t bucketCount;
+        std::uint32_t characterCount;
+        std::uint32_t reserved;
+    };
+
+    struct Entry
+    {
+        std::uint32_t hash;
+        std::uint32_t length;
+        std::uint32_t offset;
+    };
+
+    static constexpr char MAGIC[8] = {'I', 'C', 'S', '4', '6', 'I', 'M', 'G'};
+    static constexpr std::uint32_t ENDIAN_CHECK = 0x01020304;
+
+    void* image;
+    std::size_t bytes;
+    std::uint32_t count;
+    std::uint32_t bucketMask;
+    const std::uint32_t* buckets;
+    const Entry* entries;
+    const char* characters;
+    std::uint32_t characterCount;
+
+    static std::uint32_t hash_check() noexcept;
+    static std::size_t image_size(std::uint32_t count, std::uint32_t bucketCount, std::uint32_t characterCount) noexcept;
+};
+
+
+
+#endif // MAPPEDDICTIONARY_HPP
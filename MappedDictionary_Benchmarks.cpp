@@ -0,0 +1,160 @@
+// MappedDictionary_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing starting up with a MappedDictionary against
+// reading a word list into a HashSet.
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include "Benchmark.hpp"
+#include "HashSet.hpp"
+#include "MappedDictionary.hpp"
+
+
+namespace
+{
+    // evict() asks the operating system to drop the file's pages from its
+    // cache, so the next process to map it has to read it from disk.  It
+    // only works for pages that nothing else is using.
+    void evict(const std::string& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+
+        if (fd >= 0)
+        {
+            ::fdatasync(fd);
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+    }
+
+
+    long majorFaults()
+    {
+        struct rusage usage;
+        ::getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_majflt;
+    }
+
+
+    // Opens the image and looks up the queries, reporting how long the
+    // open took, how long the first lookups took (which is when the
+    // image's pages are actually read), and how many of those lookups had
+    // to wait for the disk.
+    void startMapped(const char* label, const std::string& path, const std::vector<std::string>& queries)
+    {
+        long faults = majorFaults();
+        bench::Stopwatch watch;
+
+        MappedDictionary dictionary{path};
+        double openUs = watch.elapsedMilliseconds() * 1000.0;
+
+        watch.restart();
+        unsigned int found = 0;
+
+        for (const std::string& query : queries)
+        {
+            found += dictionary.contains(query) ? 1 : 0;
+        }
+
+        double lookupMs = watch.elapsedMilliseconds();
+        bench::doNotOptimize(found);
+
+        std::printf("    %-22s open %8.1f us  first %zu lookups %8.2f ms  (%ld major faults)\n",
+            label, openUs, queries.size(), lookupMs, majorFaults() - faults);
+    }
+}
+
+
+BENCHMARK(MappedDictionary, coldAndWarmStart)
+{
+    std::string listPath = "/tmp/MappedDictionary_Benchmarks.txt";
+    std::string imagePath = "/tmp/MappedDictionary_Benchmarks.img";
+
+    for (unsigned int size : {100000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 44);
+
+        {
+            std::ofstream out{listPath};
+
+            for (const std::string& word : words)
+            {
+                out << word << '\n';
+            }
+        }
+
+        bench::Stopwatch watch;
+        MappedDictionary::writeImage(imagePath, words);
+        double writeMs = watch.elapsedMilliseconds();
+
+        std::vector<std::string> queries;
+        std::mt19937 engine{size};
+
+        for (unsigned int i = 0; i < 1000; ++i)
+        {
+            queries.push_back(words[engine() % size]);
+        }
+
+        // Starting up the old way: reading the list and adding every word.
+        watch.restart();
+        HashSet<std::string> set;
+
+        {
+            std::ifstream in{listPath};
+            std::string word;
+
+            while (in >> word)
+            {
+                set.add(word);
+            }
+        }
+
+        double rebuildMs = watch.elapsedMilliseconds();
+
+        std::printf("  %u words, %.1f MB image written in %.1f ms\n",
+            size, MappedDictionary{imagePath}.imageBytes() / 1048576.0, writeMs);
+        std::printf("    %-22s %8.1f ms\n", "HashSet from list", rebuildMs);
+
+        evict(imagePath);
+        startMapped("MappedDictionary cold", imagePath, queries);
+        startMapped("MappedDictionary warm", imagePath, queries);
+
+        // Once everything is in memory, a lookup is about as fast either way.
+        std::vector<std::string> mixed = bench::makeWords(size, 44);
+        std::vector<std::string> missing = bench::makeWords(size / 2, 45);
+        mixed.resize(size / 2);
+        mixed.insert(mixed.end(), missing.begin(), missing.end());
+        std::shuffle(mixed.begin(), mixed.end(), std::mt19937{46});
+
+        MappedDictionary dictionary{imagePath};
+
+        for (const Set<std::string>* s : {static_cast<const Set<std::string>*>(&set),
+                                          static_cast<const Set<std::string>*>(&dictionary)})
+        {
+            watch.restart();
+            unsigned int found = 0;
+
+            for (const std::string& query : mixed)
+            {
+                found += s->contains(query) ? 1 : 0;
+            }
+
+            bench::doNotOptimize(found);
+            std::printf("    %-22s contains %6.1f ns\n",
+                s == &set ? "HashSet" : "MappedDictionary", bench::nanosPerOperation(watch, mixed.size()));
+        }
+    }
+
+    std::remove(listPath.c_str());
+    std::remove(imagePath.c_str());
+}
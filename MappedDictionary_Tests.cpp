@@ -0,0 +1,157 @@
+// MappedDictionary_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for MappedDictionary, which write their images into Google
+// Test's temporary directory.
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "MappedDictionary.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::string imagePath(const std::string& name)
+    {
+        return ::testing::TempDir() + "MappedDictionary_Tests_" + name + ".img";
+    }
+}
+
+
+TEST(MappedDictionary_Tests, containsExactlyTheWordsWritten)
+{
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 5000; ++i)
+    {
+        words.push_back("WORD" + std::to_string(i * 2));
+    }
+
+    std::string path = imagePath("words");
+    MappedDictionary::writeImage(path, words);
+    MappedDictionary dictionary{path};
+
+    EXPECT_EQ(5000, dictionary.size());
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        EXPECT_EQ(i % 2 == 0, dictionary.contains("WORD" + std::to_string(i))) << i;
+    }
+
+    EXPECT_FALSE(dictionary.contains(""));
+    EXPECT_FALSE(dictionary.contains("WORD"));
+    EXPECT_FALSE(dictionary.contains("WORD00"));
+
+    std::remove(path.c_str());
+}
+
+
+TEST(MappedDictionary_Tests, duplicatesAndEmptyImagesAreHandled)
+{
+    std::string path = imagePath("small");
+
+    MappedDictionary::writeImage(path, {"CAT", "DOG", "CAT", "", "DOG"});
+    MappedDictionary small{path};
+    EXPECT_EQ(3, small.size());
+    EXPECT_TRUE(small.contains("CAT"));
+    EXPECT_TRUE(small.contains(""));
+    EXPECT_FALSE(small.contains("COW"));
+
+    // Rewriting the image doesn't disturb the one that's already mapped.
+    MappedDictionary::writeImage(path, {});
+    MappedDictionary empty{path};
+    EXPECT_EQ(0, empty.size());
+    EXPECT_FALSE(empty.contains("CAT"));
+    EXPECT_TRUE(small.contains("DOG"));
+
+    std::remove(path.c_str());
+}
+
+
+TEST(MappedDictionary_Tests, canBeUsedByAWordChecker)
+{
+    std::string path = imagePath("checker");
+    MappedDictionary::writeImage(path, {"CAT", "ACT", "AT", "CART", "BAT"});
+    MappedDictionary dictionary{path};
+    WordChecker checker{dictionary};
+
+    std::string text = "BOOCATS";
+    const StringViewLookup& lookup = dictionary;
+    EXPECT_TRUE(lookup.containsView(std::string_view{text}.substr(3, 3)));
+    EXPECT_FALSE(lookup.containsView(std::string_view{text}.substr(3)));
+
+    EXPECT_TRUE(checker.wordExists("CAT"));
+    EXPECT_EQ((std::vector<std::string>{"ACT", "CART", "AT", "BAT", "CAT"}), checker.findSuggestions("CAT"));
+
+    std::remove(path.c_str());
+}
+
+
+TEST(MappedDictionary_Tests, movesTakeTheImage)
+{
+    std::string path = imagePath("moves");
+    MappedDictionary::writeImage(path, {"APPLE", "PEAR"});
+    std::string otherPath = imagePath("other");
+    MappedDictionary::writeImage(otherPath, {"PLUM"});
+
+    MappedDictionary original{path};
+    MappedDictionary moved{std::move(original)};
+    EXPECT_EQ(0, original.size());
+    EXPECT_FALSE(original.contains("APPLE"));
+    EXPECT_TRUE(moved.contains("APPLE"));
+
+    MappedDictionary assigned{otherPath};
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.contains("PEAR"));
+    EXPECT_FALSE(assigned.contains("PLUM"));
+
+    std::remove(path.c_str());
+    std::remove(otherPath.c_str());
+}
+
+
+TEST(MappedDictionary_Tests, badImagesAreRejected)
+{
+    EXPECT_THROW(MappedDictionary{imagePath("missing")}, std::runtime_error);
+
+    std::string path = imagePath("bad");
+
+    {
+        std::ofstream out{path, std::ios::binary};
+        out << "CAT\nDOG\nAPPLE\nPEAR\nPLUM\nKIWI\nFIG\nDATE\n";
+    }
+
+    EXPECT_THROW(MappedDictionary{path}, std::runtime_error);
+
+    // A truncated image is rejected, since its header no longer agrees
+    // with its size.
+    MappedDictionary::writeImage(path, {"CAT", "DOG", "APPLE"});
+    std::string contents;
+
+    {
+        std::ifstream in{path, std::ios::binary};
+        contents.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+    }
+
+    {
+        std::ofstream out{path, std::ios::binary | std::ios::trunc};
+        out.write(contents.data(), contents.size() - 1);
+    }
+
+    EXPECT_THROW(MappedDictionary{path}, std::runtime_error);
+
+    MappedDictionary::writeImage(path, {"CAT"});
+    EXPECT_THROW(MappedDictionary{path}.add("DOG"), std::logic_error);
+
+    std::remove(path.c_str());
+}
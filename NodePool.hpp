@@ -0,0 +1,230 @@
+// NodePool.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// The node-based Set implementations don't create and destroy their nodes
+// with new and delete directly; they ask a NodeAllocator, which is named
+// as a template parameter, e.g.,
+//
+//     AVLSet<std::string, HeapNodes>    // each node is new'd and deleted
+//     AVLSet<std::string, NodePool>     // the default
+//
+// A NodeAllocator<Node> is a class template with these members:
+//
+//     template <typename... Args>
+//     Node* create(Args&&... args);    // constructs a Node{args...}
+//
+//     void destroy(Node* node);         // destroys one node from create()
+//
+//     void swap(NodeAllocator& other);  // exchanges all of the nodes
+//
+//     static constexpr bool releasesInBulk;
+//
+// Every set has its own allocator, and copying a set creates its copies of
+// the nodes with its own allocator, so allocators are never copied; moving
+// a set swaps the allocators along with the nodes.
+//
+// A NodePool carves its nodes out of large, contiguous slabs of memory, so
+// that building a set makes one call to operator new per slab rather than
+// one per element, and neighbouring nodes are likely to be near one
+// another in memory.  Destroyed nodes are kept on a free list to be reused, and the
+// slabs are all released at once when the pool is destroyed.  Because of
+// that, when releasesInBulk is true and destroying a node does nothing
+// (i.e., Node is trivially destructible), a set needn't visit its nodes at
+// all to destroy them; otherwise, it still visits each one to run its
+// destructor, but no longer frees each one separately.
+
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+
+template <typename Node>
+class HeapNodes
+{
+public:
+    static constexpr bool releasesInBulk = false;
+
+    HeapNodes() = default;
+    HeapNodes(const HeapNodes&) = delete;
+    HeapNodes& operator=(const HeapNodes&) = delete;
+
+    template <typename... Args>
+    Node* create(Args&&... args)
+    {
+        return new Node{std::forward<Args>(args)...};
+    }
+
+    void destroy(Node* node) noexcept
+    {
+        delete node;
+    }
+
+    void swap(HeapNodes&) noexcept
+    {
+    }
+};
+
+
+
+template <typename Node>
+class NodePool
+{
+public:
+    static constexpr bool releasesInBulk = true;
+
+    // The first slab holds FIRST_SLAB nodes, and each one after that is
+    // twice as large as the one before, up to MAX_SLAB nodes.
+    static constexpr std::size_t FIRST_SLAB = 32;
+    static constexpr std::size_t MAX_SLAB = 16384;
+
+    NodePool() noexcept;
+    ~NodePool() noexcept;
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    template <typename... Args>
+    Node* create(Args&&... args);
+
+    void destroy(Node* node) noexcept;
+
+    void swap(NodePool& other) noexcept;
+
+    // slabCount() returns the number of slabs allocated so far.
+    std::size_t slabCount() const noexcept;
+
+private:
+    // Each slot either holds a node or, when it's free, points to the next
+    // free slot.  The first slot of each slab instead points to the slab
+    // allocated before it, so that they can all be found to release them.
+    union Slot
+    {
+        Slot* next;
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    Slot* slabs;
+    Slot* freeSlots;
+    Slot* unused;
+    std::size_t unusedCount;
+    std::size_t nextSlabSize;
+    std::size_t slabsAllocated;
+
+    void addSlab();
+};
+
+
+
+template <typename Node>
+NodePool<Node>::NodePool() noexcept
+    : slabs{nullptr}, freeSlots{nullptr}, unused{nullptr}, unusedCount{0},
+      nextSlabSize{FIRST_SLAB}, slabsAllocated{0}
+{
+}
+
+
+template <typename Node>
+NodePool<Node>::~NodePool() noexcept
+{
+    while (slabs != nullptr)
+    {
+        Slot* previous = slabs->next;
+        ::operator delete(slabs);
+        slabs = previous;
+    }
+}
+
+
+template <typename Node>
+template <typename... Args>
+Node* NodePool<Node>::create(Args&&... args)
+{
+    Slot* slot;
+
+    if (freeSlots != nullptr)
+    {
+        slot = freeSlots;
+        freeSlots = slot->next;
+    }
+    else
+    {
+        if (unusedCount == 0)
+        {
+            addSlab();
+        }
+
+        slot = unused++;
+        unusedCount--;
+    }
+
+    try
+    {
+        return ::new (static_cast<void*>(slot->storage)) Node{std::forward<Args>(args)...};
+    }
+    catch (...)
+    {
+        slot->next = freeSlots;
+        freeSlots = slot;
+        throw;
+    }
+}
+
+
+template <typename Node>
+void NodePool<Node>::destroy(Node* node) noexcept
+{
+    node->~Node();
+
+    Slot* slot = reinterpret_cast<Slot*>(node);
+    slot->next = freeSlots;
+    freeSlots = slot;
+}
+
+
+template <typename Node>
+void NodePool<Node>::swap(NodePool& other) noexcept
+{
+    std::swap(slabs, other.slabs);
+    std::swap(freeSlots, other.freeSlots);
+    std::swap(unused, other.unused);
+    std::swap(unusedCount, other.unusedCount);
+    std::swap(nextSlabSize, other.nextSlabSize);
+    std::swap(slabsAllocated, other.slabsAllocated);
+}
+
+
+template <typename Node>
+std::size_t NodePool<Node>::slabCount() const noexcept
+{
+    return slabsAllocated;
+}
+
+
+template <typename Node>
+void NodePool<Node>::addSlab()
+{
+    static_assert(alignof(Slot) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+        "NodePool doesn't support over-aligned nodes");
+
+    Slot* slab = static_cast<Slot*>(::operator new(sizeof(Slot) * (nextSlabSize + 1)));
+    slab->next = slabs;
+    slabs = slab;
+
+    unused = slab + 1;
+    unusedCount = nextSlabSize;
+    nextSlabSize = std::min(nextSlabSize * 2, MAX_SLAB);
+    slabsAllocated++;
+}
+
+
+
+#endif // NODEPOOL_HPP
+
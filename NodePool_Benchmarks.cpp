@@ -0,0 +1,85 @@
+// NodePool_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing the node allocators used by the Set
+// implementations.
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmark.hpp"
+#include "HashSet.hpp"
+#include "NodePool.hpp"
+
+
+namespace
+{
+    template <typename SetType, typename ElementType>
+    std::unique_ptr<SetType> build(const std::vector<ElementType>& elements)
+    {
+        auto set = std::make_unique<SetType>();
+
+        for (const ElementType& element : elements)
+        {
+            set->add(element);
+        }
+
+        return set;
+    }
+
+
+    // Builds a set of the given elements and then destroys it, reporting
+    // how long each took and how many allocations the build made.  The set
+    // is built and destroyed once beforehand, so that neither allocator is
+    // charged for the first use of fresh memory from the operating system.
+    template <typename SetType, typename ElementType>
+    void measureBuildAndDestroy(const char* label, const std::vector<ElementType>& elements)
+    {
+        build<SetType>(elements).reset();
+
+        std::size_t allocationsBefore = bench::allocationCount();
+        bench::Stopwatch watch;
+        std::unique_ptr<SetType> set = build<SetType>(elements);
+        double buildMs = watch.elapsedMilliseconds();
+        std::size_t allocations = bench::allocationCount() - allocationsBefore;
+
+        watch.restart();
+        set.reset();
+        double destroyMs = watch.elapsedMilliseconds();
+
+        std::printf("  %-20s build %7.1f ms  destroy %6.1f ms  %8zu allocations\n",
+            label, buildMs, destroyMs, allocations);
+    }
+}
+
+
+BENCHMARK(NodePool, buildAndDestroy)
+{
+    for (unsigned int size : {250000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 13);
+        std::vector<int> numbers;
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            numbers.push_back(static_cast<int>(i * 2654435761u));
+        }
+
+        std::printf("  %u words\n", size);
+        measureBuildAndDestroy<AVLSet<std::string, HeapNodes>>("AVLSet, heap", words);
+        measureBuildAndDestroy<AVLSet<std::string, NodePool>>("AVLSet, pool", words);
+        measureBuildAndDestroy<HashSet<std::string, DefaultHash<std::string>, HeapNodes>>("HashSet, heap", words);
+        measureBuildAndDestroy<HashSet<std::string, DefaultHash<std::string>, NodePool>>("HashSet, pool", words);
+
+        std::printf("  %u ints\n", size);
+        measureBuildAndDestroy<AVLSet<int, HeapNodes>>("AVLSet, heap", numbers);
+        measureBuildAndDestroy<AVLSet<int, NodePool>>("AVLSet, pool", numbers);
+        measureBuildAndDestroy<HashSet<int, DefaultHash<int>, HeapNodes>>("HashSet, heap", numbers);
+        measureBuildAndDestroy<HashSet<int, DefaultHash<int>, NodePool>>("HashSet, pool", numbers);
+    }
+}
+
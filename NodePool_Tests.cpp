@@ -0,0 +1,116 @@
+// NodePool_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for NodePool and the Set implementations that use it.
+
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "NodePool.hpp"
+
+
+namespace
+{
+    struct Counted
+    {
+        int value;
+        int* destroyed;
+
+        ~Counted()
+        {
+            ++*destroyed;
+        }
+    };
+}
+
+
+TEST(NodePool_Tests, carvesNodesOutOfGrowingSlabs)
+{
+    NodePool<Counted> pool;
+    int destroyed = 0;
+
+    for (int i = 0; i < 992; ++i)
+    {
+        Counted* c = pool.create(i, &destroyed);
+        EXPECT_EQ(i, c->value);
+    }
+
+    // 32 + 64 + 128 + 256 + 512 = 992
+    EXPECT_EQ(5, pool.slabCount());
+
+    pool.create(992, &destroyed);
+    EXPECT_EQ(6, pool.slabCount());
+}
+
+
+TEST(NodePool_Tests, destroyingRunsTheDestructorAndReusesTheNode)
+{
+    NodePool<Counted> pool;
+    int destroyed = 0;
+
+    Counted* first = pool.create(1, &destroyed);
+    pool.create(2, &destroyed);
+    pool.destroy(first);
+
+    EXPECT_EQ(1, destroyed);
+    EXPECT_EQ(first, pool.create(3, &destroyed));
+    EXPECT_EQ(3, first->value);
+}
+
+
+TEST(NodePool_Tests, swappingExchangesTheNodes)
+{
+    NodePool<Counted> a;
+    NodePool<Counted> b;
+    int destroyed = 0;
+
+    Counted* c = a.create(1, &destroyed);
+    a.swap(b);
+
+    EXPECT_EQ(0, a.slabCount());
+    EXPECT_EQ(1, b.slabCount());
+
+    b.destroy(c);
+    EXPECT_EQ(1, destroyed);
+}
+
+
+TEST(NodePool_Tests, setsWorkWithEitherAllocator)
+{
+    AVLSet<std::string, HeapNodes> heapTree;
+    AVLSet<std::string, NodePool> pooledTree;
+    HashSet<std::string, DefaultHash<std::string>, HeapNodes> heapHash;
+    HashSet<std::string, DefaultHash<std::string>, NodePool> pooledHash;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        heapTree.add(word);
+        pooledTree.add(word);
+        heapHash.add(word);
+        pooledHash.add(word);
+    }
+
+    AVLSet<std::string> copiedTree{pooledTree};
+    AVLSet<std::string> movedTree{std::move(copiedTree)};
+    HashSet<std::string> copiedHash{pooledHash};
+    HashSet<std::string> movedHash;
+    movedHash = std::move(copiedHash);
+
+    for (int i = 0; i < 600; ++i)
+    {
+        std::string word = "WORD" + std::to_string(i);
+        bool expected = i < 500;
+        EXPECT_EQ(expected, heapTree.contains(word));
+        EXPECT_EQ(expected, pooledTree.contains(word));
+        EXPECT_EQ(expected, movedTree.contains(word));
+        EXPECT_EQ(expected, heapHash.contains(word));
+        EXPECT_EQ(expected, pooledHash.contains(word));
+        EXPECT_EQ(expected, movedHash.contains(word));
+    }
+}
+
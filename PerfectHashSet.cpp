@@ -0,0 +1,370 @@
+// PerfectHashSet.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include "Hashing.hpp"
+#include "PerfectHashSet.hpp"
+
+
+namespace
+{
+    // Seeds are tried in order until one works, which nearly always means
+    // the first one.
+    const unsigned int MAX_SEEDS = 16;
+
+
+    std::size_t storageSize(std::uint32_t count, std::uint32_t bucketCount, std::size_t characterCount) noexcept
+    {
+        return bucketCount * sizeof(std::uint32_t) + (count + std::size_t{1}) * sizeof(std::uint32_t)
+            + count + characterCount;
+    }
+}
+
+
+PerfectHashSet::PerfectHashSet()
+    : storage{nullptr}, storageBytes{0}, count{0}, bucketCount{0}, seed{0},
+      pilots{nullptr}, offsets{nullptr}, fingerprints{nullptr}, characters{nullptr}
+{
+}
+
+
+PerfectHashSet::PerfectHashSet(std::vector<std::string> words)
+    : PerfectHashSet{}
+{
+    build(words);
+}
+
+
+PerfectHashSet::~PerfectHashSet() noexcept
+{
+    delete[] storage;
+}
+
+
+PerfectHashSet::PerfectHashSet(const PerfectHashSet& s)
+    : PerfectHashSet{}
+{
+    if (s.storage != nullptr)
+    {
+        storage = new unsigned char[s.storageBytes];
+        std::memcpy(storage, s.storage, s.storageBytes);
+        storageBytes = s.storageBytes;
+        count = s.count;
+        bucketCount = s.bucketCount;
+        seed = s.seed;
+        point_into_storage();
+    }
+}
+
+
+PerfectHashSet::PerfectHashSet(PerfectHashSet&& s) noexcept
+    : PerfectHashSet{}
+{
+    *this = std::move(s);
+}
+
+
+PerfectHashSet& PerfectHashSet::operator=(const PerfectHashSet& s)
+{
+    if (this != &s)
+    {
+        PerfectHashSet copied{s};
+        *this = std::move(copied);
+    }
+
+    return *this;
+}
+
+
+PerfectHashSet& PerfectHashSet::operator=(PerfectHashSet&& s) noexcept
+{
+    std::swap(storage, s.storage);
+    std::swap(storageBytes, s.storageBytes);
+    std::swap(count, s.count);
+    std::swap(bucketCount, s.bucketCount);
+    std::swap(seed, s.seed);
+    std::swap(pilots, s.pilots);
+    std::swap(offsets, s.offsets);
+    std::swap(fingerprints, s.fingerprints);
+    std::swap(characters, s.characters);
+    return *this;
+}
+
+
+bool PerfectHashSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void PerfectHashSet::add(const std::string&)
+{
+    throw std::logic_error{"PerfectHashSet can't be added to"};
+}
+
+
+bool PerfectHashSet::contains(const std::string& element) const
+{
+    return containsKey(element);
+}
+
+
+bool PerfectHashSet::containsKey(std::string_view key) const
+{
+    if (count == 0)
+    {
+        return false;
+    }
+
+    std::uint64_t hash = hashing::hashBytes(key.data(), key.size(), seed);
+    std::uint32_t slot = slot_of(hash, pilots[bucket_of(hash, bucketCount)], count);
+
+    if (fingerprints[slot] != static_cast<std::uint8_t>(hash))
+    {
+        return false;
+    }
+
+    std::uint32_t begin = offsets[slot];
+    std::uint32_t end = offsets[slot + 1];
+
+    return end - begin == key.size() && std::memcmp(characters + begin, key.data(), key.size()) == 0;
+}
+
+
+unsigned int PerfectHashSet::size() const noexcept
+{
+    return count;
+}
+
+
+std::size_t PerfectHashSet::memoryUsage() const noexcept
+{
+    return storageBytes;
+}
+
+
+std::size_t PerfectHashSet::indexBytes() const noexcept
+{
+    return storage == nullptr ? 0 : storageBytes - offsets[count];
+}
+
+
+void PerfectHashSet::build(std::vector<std::string>& words)
+{
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    std::size_t characterCount = 0;
+
+    for (const std::string& word : words)
+    {
+        characterCount += word.size();
+    }
+
+    if (words.size() >= UINT32_MAX || characterCount >= UINT32_MAX)
+    {
+        throw std::length_error{"too many words for a PerfectHashSet"};
+    }
+
+    for (unsigned int attempt = 0; attempt < MAX_SEEDS; ++attempt)
+    {
+        if (try_seed(words, hashing::mix64(attempt + 1)))
+        {
+            return;
+        }
+    }
+
+    throw std::runtime_error{"couldn't find a perfect hash function for the words"};
+}
+
+
+bool PerfectHashSet::try_seed(const std::vector<std::string>& words, std::uint64_t newSeed)
+{
+    std::uint32_t newCount = static_cast<std::uint32_t>(words.size());
+    std::uint32_t newBucketCount = (newCount + KEYS_PER_BUCKET - 1) / KEYS_PER_BUCKET;
+
+    std::vector<std::uint64_t> hashes(newCount);
+
+    for (std::uint32_t i = 0; i < newCount; ++i)
+    {
+        hashes[i] = hashing::hashBytes(words[i].data(), words[i].size(), newSeed);
+    }
+
+    // The words are grouped by bucket with a counting sort, so bucket b's
+    // words are members[bucketStarts[b]] up to members[bucketStarts[b + 1]].
+    std::vector<std::uint32_t> bucketStarts(newBucketCount + 1, 0);
+    std::vector<std::uint32_t> members(newCount);
+
+    for (std::uint32_t i = 0; i < newCount; ++i)
+    {
+        bucketStarts[bucket_of(hashes[i], newBucketCount) + 1]++;
+    }
+
+    for (std::uint32_t b = 0; b < newBucketCount; ++b)
+    {
+        bucketStarts[b + 1] += bucketStarts[b];
+    }
+
+    {
+        std::vector<std::uint32_t> next(bucketStarts.begin(), bucketStarts.end() - 1);
+
+        for (std::uint32_t i = 0; i < newCount; ++i)
+        {
+            members[next[bucket_of(hashes[i], newBucketCount)]++] = i;
+        }
+    }
+
+    std::vector<std::uint32_t> order(newBucketCount);
+
+    for (std::uint32_t b = 0; b < newBucketCount; ++b)
+    {
+        order[b] = b;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](std::uint32_t a, std::uint32_t b)
+    {
+        return bucketStarts[a + 1] - bucketStarts[a] > bucketStarts[b + 1] - bucketStarts[b];
+    });
+
+    std::vector<std::uint32_t> newPilots(newBucketCount, 0);
+    std::vector<std::uint32_t> slots(newCount);
+    std::vector<bool> taken(newCount, false);
+    std::vector<std::uint32_t> trial;
+
+    // The last bucket placed has one slot left to go to, which a pilot
+    // finds with probability 1 / n per try; giving up after 64n tries
+    // fails once in e^64 times.
+    std::uint64_t maxPilot = std::min<std::uint64_t>(std::uint64_t{newCount} * 64 + 1024, UINT32_MAX);
+
+    for (std::uint32_t b : order)
+    {
+        std::uint32_t first = bucketStarts[b];
+        std::uint32_t last = bucketStarts[b + 1];
+
+        if (first == last)
+        {
+            break;
+        }
+
+        // Two words with the same hash always go to the same slot, so no
+        // pilot can work; only a new seed can.
+        for (std::uint32_t i = first; i < last; ++i)
+        {
+            for (std::uint32_t j = first; j < i; ++j)
+            {
+                if (hashes[members[i]] == hashes[members[j]])
+                {
+                    return false;
+                }
+            }
+        }
+
+        std::uint64_t pilot = 0;
+
+        for (; pilot < maxPilot; ++pilot)
+        {
+            trial.clear();
+
+            for (std::uint32_t i = first; i < last; ++i)
+            {
+                std::uint32_t slot = slot_of(hashes[members[i]], static_cast<std::uint32_t>(pilot), newCount);
+
+                if (taken[slot] || std::find(trial.begin(), trial.end(), slot) != trial.end())
+                {
+                    break;
+                }
+
+                trial.push_back(slot);
+            }
+
+            if (trial.size() == last - first)
+            {
+                break;
+            }
+        }
+
+        if (pilot == maxPilot)
+        {
+            return false;
+        }
+
+        newPilots[b] = static_cast<std::uint32_t>(pilot);
+
+        for (std::uint32_t i = first; i < last; ++i)
+        {
+            slots[members[i]] = trial[i - first];
+            taken[trial[i - first]] = true;
+        }
+    }
+
+    // Now that every word has a slot, the words are laid out in slot order.
+    std::vector<std::uint32_t> wordInSlot(newCount);
+    std::size_t characterCount = 0;
+
+    for (std::uint32_t i = 0; i < newCount; ++i)
+    {
+        wordInSlot[slots[i]] = i;
+        characterCount += words[i].size();
+    }
+
+    std::size_t newBytes = storageSize(newCount, newBucketCount, characterCount);
+    unsigned char* newStorage = new unsigned char[newBytes];
+
+    std::uint32_t* pilotArea = reinterpret_cast<std::uint32_t*>(newStorage);
+    std::uint32_t* offsetArea = pilotArea + newBucketCount;
+    std::uint8_t* fingerprintArea = reinterpret_cast<std::uint8_t*>(offsetArea + newCount + 1);
+    char* characterArea = reinterpret_cast<char*>(fingerprintArea + newCount);
+
+    std::copy(newPilots.begin(), newPilots.end(), pilotArea);
+    std::uint32_t offset = 0;
+
+    for (std::uint32_t slot = 0; slot < newCount; ++slot)
+    {
+        const std::string& word = words[wordInSlot[slot]];
+        offsetArea[slot] = offset;
+        fingerprintArea[slot] = static_cast<std::uint8_t>(hashes[wordInSlot[slot]]);
+        std::memcpy(characterArea + offset, word.data(), word.size());
+        offset += static_cast<std::uint32_t>(word.size());
+    }
+
+    offsetArea[newCount] = offset;
+
+    delete[] storage;
+    storage = newStorage;
+    storageBytes = newBytes;
+    count = newCount;
+    bucketCount = newBucketCount;
+    seed = newSeed;
+    point_into_storage();
+
+    return true;
+}
+
+
+void PerfectHashSet::point_into_storage() noexcept
+{
+    pilots = reinterpret_cast<const std::uint32_t*>(storage);
+    offsets = pilots + bucketCount;
+    fingerprints = reinterpret_cast<const std::uint8_t*>(offsets + count + 1);
+    characters = reinterpret_cast<const char*>(fingerprints + count);
+}
+
+
+std::uint32_t PerfectHashSet::bucket_of(std::uint64_t hash, std::uint32_t bucketCount) noexcept
+{
+    // Multiplying a 32-bit value by n and keeping the high 32 bits maps it
+    // onto 0 through n - 1 as evenly as a modulus would, without dividing.
+    return static_cast<std::uint32_t>(((hash >> 32) * bucketCount) >> 32);
+}
+
+
+std::uint32_t PerfectHashSet::slot_of(std::uint64_t hash, std::uint32_t pilot, std::uint32_t count) noexcept
+{
+    std::uint64_t mixed = hashing::mix64(hash ^ (pilot * 0x9e3779b97f4a7c15ull));
+    return static_cast<std::uint32_t>(((mixed & 0xffffffffull) * count) >> 32);
+}
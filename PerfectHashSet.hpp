@@ -0,0 +1,166 @@
+// PerfectHashSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A PerfectHashSet is a read-only Set of strings, built once from a list
+// of words (or from a Set that can visit its elements, such as an AVLSet),
+// e.g.,
+//
+//     AVLSet<std::string> words;
+//     ...
+//     PerfectHashSet perfect{words};
+//     WordChecker checker{perfect};
+//
+// It stores its n words in an array of exactly n slots, using a minimal
+// perfect hash function: one that sends each of its words to a different
+// slot.  So there are no collisions to resolve, and a lookup hashes the key
+// once, computes its slot, and compares the key to the one word in that
+// slot; there are no chains (or probe sequences) to walk.
+//
+// The hash function is found with the "hash and displace" method (as in
+// CHD).  Each word's hash picks one of about n / KEYS_PER_BUCKET buckets,
+// and each bucket has a "pilot" value, chosen while the set is built;
+// the word's slot is computed from its hash and its bucket's pilot.  The
+// buckets are placed largest first, and each one gets the smallest pilot
+// that sends all of its words to slots that are still empty.  Large
+// buckets are placed while nearly every slot is empty, so they find a
+// pilot quickly, and the single-word buckets placed last can go anywhere.
+// In the rare case that two words have exactly the same hash, no pilot
+// can separate them, so the set is built again with a different seed.
+//
+// Most of the words WordChecker looks up are misspellings that aren't in
+// the set.  A missing key still leads to some slot, so each slot also has
+// a one-byte fingerprint of its word's hash, which the key's hash has to
+// match before the words are compared; all but one in 256 missing keys
+// are turned away without looking at any characters.
+//
+// The words themselves are stored one after another, in slot order, with
+// an array giving where each slot's word begins.  Everything is stored in
+// a single dynamically-allocated block.
+//
+// Since a PerfectHashSet can't change once it's been built, add() throws
+// a std::logic_error.
+
+#ifndef PERFECTHASHSET_HPP
+#define PERFECTHASHSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+
+class PerfectHashSet : public Set<std::string>,
+    public TransparentLookup<std::string, PerfectHashSet>
+{
+public:
+    // The average number of words per bucket.  Fewer pilots take less
+    // memory, but larger buckets take longer to place.
+    static constexpr unsigned int KEYS_PER_BUCKET = 4;
+
+public:
+    // Initializes a PerfectHashSet to be empty.
+    PerfectHashSet();
+
+    // Initializes a PerfectHashSet to contain the given words, ignoring
+    // any duplicates.
+    explicit PerfectHashSet(std::vector<std::string> words);
+
+    // Initializes a PerfectHashSet to contain the elements of the given
+    // set, which must have an inorder() function that visits each of them,
+    // as AVLSet does.
+    template <typename TraversableSet>
+    explicit PerfectHashSet(const TraversableSet& s);
+
+    // Cleans up the PerfectHashSet so that it leaks no memory.
+    virtual ~PerfectHashSet() noexcept;
+
+    // Initializes a new PerfectHashSet to be a copy of an existing one.
+    PerfectHashSet(const PerfectHashSet& s);
+
+    // Initializes a new PerfectHashSet whose contents are moved from an
+    // expiring one.
+    PerfectHashSet(PerfectHashSet&& s) noexcept;
+
+    // Assigns an existing PerfectHashSet into another.
+    PerfectHashSet& operator=(const PerfectHashSet& s);
+
+    // Assigns an expiring PerfectHashSet into another.
+    PerfectHashSet& operator=(PerfectHashSet&& s) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() always throws a std::logic_error, because a PerfectHashSet
+    // can't be changed.
+    virtual void add(const std::string& element) override;
+
+
+    // contains() returns true if the given word is in the set, false
+    // otherwise.  This function always runs in O(1) time, hashing the
+    // word once and comparing it to at most one other word.
+    virtual bool contains(const std::string& element) const override;
+
+
+    // containsKey() is like contains(), but accepts a std::string_view.
+    bool containsKey(std::string_view key) const;
+
+
+    // size() returns the number of words in the set.
+    virtual unsigned int size() const noexcept override;
+
+
+    // memoryUsage() returns the number of bytes used to store the set,
+    // including the characters of its words.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // indexBytes() returns the number of bytes used to store everything
+    // but the characters of the words: the pilots, the fingerprints, and
+    // where each word begins.
+    std::size_t indexBytes() const noexcept;
+
+
+private:
+    unsigned char* storage;
+    std::size_t storageBytes;
+    std::uint32_t count;
+    std::uint32_t bucketCount;
+    std::uint64_t seed;
+
+    // These point into storage.  offsets has count + 1 elements, so slot
+    // i's word is characters[offsets[i]] up to characters[offsets[i + 1]].
+    const std::uint32_t* pilots;
+    const std::uint32_t* offsets;
+    const std::uint8_t* fingerprints;
+    const char* characters;
+
+    void build(std::vector<std::string>& words);
+    bool try_seed(const std::vector<std::string>& words, std::uint64_t seed);
+    void point_into_storage() noexcept;
+
+    static std::uint32_t bucket_of(std::uint64_t hash, std::uint32_t bucketCount) noexcept;
+    static std::uint32_t slot_of(std::uint64_t hash, std::uint32_t pilot, std::uint32_t count) noexcept;
+};
+
+
+
+template <typename TraversableSet>
+PerfectHashSet::PerfectHashSet(const TraversableSet& s)
+    : PerfectHashSet{}
+{
+    std::vector<std::string> words;
+    words.reserve(s.size());
+    s.inorder([&](const std::string& word) { words.push_back(word); });
+    build(words);
+}
+
+
+
+#endif // PERFECTHASHSET_HPP
@@ -0,0 +1,110 @@
+// PerfectHashSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing PerfectHashSet with the other hash-based Sets.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "FlatHashSet.hpp"
+#include "HashSet.hpp"
+#include "PerfectHashSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    // Looks up each of the queries, returning the number of lookups per
+    // second, in millions.
+    template <typename SetType>
+    double lookupRate(const SetType& set, const std::vector<std::string>& queries)
+    {
+        bench::Stopwatch watch;
+        unsigned int found = 0;
+
+        for (const std::string& query : queries)
+        {
+            found += set.contains(query) ? 1 : 0;
+        }
+
+        bench::doNotOptimize(found);
+        return queries.size() / watch.elapsedMilliseconds() / 1000.0;
+    }
+
+
+    template <typename SetType>
+    void measureSet(
+        const char* label, const SetType& set,
+        const std::vector<std::string>& hits, const std::vector<std::string>& misses,
+        const std::vector<std::string>& misspellings)
+    {
+        WordChecker checker{set};
+        bench::Stopwatch watch;
+        std::size_t suggestions = 0;
+
+        for (const std::string& word : misspellings)
+        {
+            suggestions += checker.findSuggestions(word).size();
+        }
+
+        double suggestUs = watch.elapsedMilliseconds() * 1000.0 / misspellings.size();
+        bench::doNotOptimize(suggestions);
+
+        std::printf("    %-16s hits %6.2fM/s  misses %6.2fM/s  findSuggestions %7.2f us\n",
+            label, lookupRate(set, hits), lookupRate(set, misses), suggestUs);
+    }
+}
+
+
+BENCHMARK(PerfectHashSet, versusHashSets)
+{
+    for (unsigned int size : {10000u, 100000u, 1000000u})
+    {
+        std::vector<std::string> all = bench::makeWords(size * 2, 47);
+        std::vector<std::string> words{all.begin(), all.begin() + size};
+        std::vector<std::string> misses{all.begin() + size, all.end()};
+        std::vector<std::string> hits = words;
+        std::shuffle(hits.begin(), hits.end(), std::mt19937{48});
+
+        // Misspellings with one letter replaced, like the ones WordChecker
+        // gets, most of whose candidates aren't words.
+        std::vector<std::string> misspellings;
+        std::mt19937 engine{49};
+
+        for (unsigned int i = 0; i < 2000; ++i)
+        {
+            std::string word = words[engine() % size];
+            word[engine() % word.size()] = static_cast<char>('A' + engine() % 26);
+            misspellings.push_back(word);
+        }
+
+        bench::Stopwatch watch;
+        PerfectHashSet perfect{words};
+        double buildMs = watch.elapsedMilliseconds();
+
+        std::size_t characters = perfect.memoryUsage() - perfect.indexBytes();
+
+        std::printf("  %u words  build %.1f ms  %.1f bits/key for the index, %.1f bits/key with the words\n",
+            size, buildMs, perfect.indexBytes() * 8.0 / size, perfect.memoryUsage() * 8.0 / size);
+        std::printf("    (the words themselves average %.1f characters)\n",
+            static_cast<double>(characters) / size);
+
+        HashSet<std::string> chained;
+        FlatHashSet<std::string> flat{bench::stringHash};
+
+        for (const std::string& word : words)
+        {
+            chained.add(word);
+            flat.add(word);
+        }
+
+        measureSet("PerfectHashSet", perfect, hits, misses, misspellings);
+        measureSet("HashSet", chained, hits, misses, misspellings);
+        measureSet("FlatHashSet", flat, hits, misses, misspellings);
+    }
+}
@@ -0,0 +1,115 @@
+// PerfectHashSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for PerfectHashSet.
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "PerfectHashSet.hpp"
+#include "WordChecker.hpp"
+
+
+TEST(PerfectHashSet_Tests, emptySetContainsNothing)
+{
+    PerfectHashSet empty;
+    PerfectHashSet built{std::vector<std::string>{}};
+
+    for (const PerfectHashSet* s : {&empty, &built})
+    {
+        EXPECT_EQ(0, s->size());
+        EXPECT_FALSE(s->contains(""));
+        EXPECT_FALSE(s->contains("CAT"));
+    }
+}
+
+
+TEST(PerfectHashSet_Tests, containsExactlyTheWordsItWasBuiltFrom)
+{
+    for (int size : {1, 2, 3, 5, 17, 1000, 20000})
+    {
+        std::vector<std::string> words;
+
+        for (int i = 0; i < size; ++i)
+        {
+            words.push_back("WORD" + std::to_string(i * 2));
+        }
+
+        PerfectHashSet s{words};
+        EXPECT_EQ(size, s.size());
+
+        for (int i = 0; i < size * 2; ++i)
+        {
+            EXPECT_EQ(i % 2 == 0, s.contains("WORD" + std::to_string(i))) << size << " words, " << i;
+        }
+
+        EXPECT_FALSE(s.contains(""));
+        EXPECT_FALSE(s.contains("WORD"));
+    }
+}
+
+
+TEST(PerfectHashSet_Tests, duplicatesAreIgnored)
+{
+    PerfectHashSet s{std::vector<std::string>{"CAT", "DOG", "CAT", "", "DOG", "CAT"}};
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains(""));
+    EXPECT_TRUE(s.contains("CAT"));
+    EXPECT_TRUE(s.contains("DOG"));
+    EXPECT_FALSE(s.contains("CA"));
+    EXPECT_FALSE(s.contains("CATS"));
+}
+
+
+TEST(PerfectHashSet_Tests, canBeBuiltFromATraversableSet)
+{
+    AVLSet<std::string> avl;
+
+    for (std::string word : {"CAT", "ACT", "AT", "CART", "BAT"})
+    {
+        avl.add(word);
+    }
+
+    PerfectHashSet s{avl};
+    WordChecker checker{s};
+
+    EXPECT_EQ(5, s.size());
+    EXPECT_EQ((std::vector<std::string>{"ACT", "CART", "AT", "BAT", "CAT"}), checker.findSuggestions("CAT"));
+
+    std::string text = "BOOCATS";
+    const StringViewLookup& lookup = s;
+    EXPECT_TRUE(lookup.containsView(std::string_view{text}.substr(3, 3)));
+    EXPECT_FALSE(lookup.containsView(std::string_view{text}.substr(3)));
+}
+
+
+TEST(PerfectHashSet_Tests, copiesAndMovesKeepTheWords)
+{
+    PerfectHashSet original{std::vector<std::string>{"APPLE", "PEAR", "PLUM"}};
+    PerfectHashSet copied{original};
+    PerfectHashSet assigned{std::vector<std::string>{"KIWI"}};
+    assigned = original;
+
+    PerfectHashSet moved{std::move(original)};
+    EXPECT_EQ(0, original.size());
+    EXPECT_FALSE(original.contains("APPLE"));
+    EXPECT_EQ(0, original.indexBytes());
+
+    for (const PerfectHashSet* s : {&copied, &assigned, &moved})
+    {
+        EXPECT_EQ(3, s->size());
+        EXPECT_TRUE(s->contains("PEAR"));
+        EXPECT_FALSE(s->contains("KIWI"));
+    }
+
+    EXPECT_EQ(moved.memoryUsage(), copied.memoryUsage());
+    EXPECT_EQ(moved.memoryUsage(), moved.indexBytes() + 13);
+    EXPECT_THROW(moved.add("KIWI"), std::logic_error);
+}
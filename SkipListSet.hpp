@@ -24,9 +24,18 @@
 #ifndef SKIPLISTSET_HPP
 #define SKIPLISTSET_HPP
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <random>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "NodePool.hpp"
 #include "Set.hpp"
+#include "StringLookup.hpp"
 
 
 
@@ -168,8 +177,23 @@ std::unique_ptr<SkipListLevelTester<ElementType>> RandomSkipListLevelTester<Elem
 
 
 
-template <typename ElementType>
-class SkipListSet : public Set<ElementType>
+// Each node holds its own copy of its element, alongside the two pointers,
+// so that a search compares against the element in the node it's already
+// looking at rather than following a third pointer somewhere else.  The
+// nodes are created and destroyed by the NodeAllocator named in the
+// SkipListSet's type (see NodePool.hpp), which defaults to a NodePool, so
+// that the nodes of one level (which are usually added near the same time
+// as their neighbours) tend to be near one another in memory.
+//
+// The node at the beginning of each level is -INF; the null pointer at the
+// end of each level is +INF.  Because searches always begin at -INF and
+// never compare against it, its element is default-constructed and never
+// looked at, so ElementType must be default-constructible.
+
+template <typename ElementType, template <typename> typename NodeAllocator = NodePool>
+class SkipListSet : public Set<ElementType>,
+    public TransparentLookup<ElementType, SkipListSet<ElementType, NodeAllocator>>,
+    public OrderedLookup<ElementType, SkipListSet<ElementType, NodeAllocator>>
 {
 public:
     // Initializes an SkipListSet to be empty, with or without a
@@ -207,6 +231,22 @@ public:
     virtual void add(const ElementType& element) override;
 
 
+    // addSorted() adds every element in the range [first, last) to the set
+    // and rebuilds the skip list so that its levels are perfectly even: the
+    // 2^k-th, 2 * 2^k-th, 3 * 2^k-th (and so on) smallest elements occupy
+    // level k, so there are floor(log2 n) + 1 levels and a search visits
+    // at most two nodes on each.  The levels are built bottom-up in one
+    // pass, without the level tester, in O(n) time when the set is empty
+    // and the range is sorted (as a dictionary file usually is).
+    // Otherwise, the range is copied and sorted, and then merged with the
+    // elements already in the set, which takes O(n log n + m) time when
+    // there are m elements in the set already.  Either way, duplicates
+    // have no effect.  Elements added later with add() are promoted by the
+    // level tester as usual.
+    template <typename InputIterator>
+    void addSorted(InputIterator first, InputIterator last);
+
+
     // contains() returns true if the given element is already in the set,
     // false otherwise.  This function runs in an expected time of O(log n)
     // (i.e., over the long run, we expect the average to be O(log n))
@@ -214,6 +254,27 @@ public:
     virtual bool contains(const ElementType& element) const override;
 
 
+    // containsKey() is like contains(), except that it accepts any key that
+    // can be compared to the elements, such as a std::string_view when the
+    // elements are std::strings.
+    template <typename Key>
+    bool containsKey(const Key& key) const;
+
+
+    // containsSorted() writes to "out", for each key in the range
+    // [first, last), whether the set contains it, and returns the output
+    // iterator just past the last result written.  The keys must be in
+    // ascending order (duplicates are fine), so that each search can begin
+    // where the previous one left off instead of at the top of the -INF
+    // column: it climbs only as many levels as it needs to skip past the
+    // elements between the previous key and this one.  Looking up m sorted
+    // keys this way takes an expected O(m log(n / m)) time, rather than the
+    // O(m log n) time it takes to call contains() for each one.  (The keys
+    // can be anything containsKey() accepts.)
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator containsSorted(InputIterator first, InputIterator last, OutputIterator out) const;
+
+
     // size() returns the number of elements in the set.
     virtual unsigned int size() const noexcept override;
 
@@ -237,103 +298,650 @@ public:
     bool isElementOnLevel(const ElementType& element, unsigned int level) const;
 
 
+    // prefixScan() calls the given "visit" function for each element in
+    // the set that begins with the given prefix, in ascending order,
+    // stopping after it has visited "limit" of them, and returns the number
+    // of elements visited.  The first such element is found in expected
+    // O(log n) time, after which the scan walks along the bottom level
+    // until it reaches an element that doesn't begin with the prefix.  (It
+    // can only be used when the elements can be viewed as a
+    // std::string_view, e.g., when they're std::strings.)
+    template <typename Visitor>
+    unsigned int prefixScan(std::string_view prefix, unsigned int limit, Visitor&& visit) const;
+
+
 private:
+    struct Node
+    {
+        ElementType element;
+        Node* next;
+        Node* down;
+    };
+
+    // A SkipListSet that's been moved from has no level tester; a new
+    // RandomSkipListLevelTester is created when one is next needed, so
+    // that moving never allocates.
     std::unique_ptr<SkipListLevelTester<ElementType>> levelTester;
+    NodeAllocator<Node> nodes;
+
+    // The -INF node on the top level.  It's created when the first element
+    // is added, so that an empty set (including one that's been moved
+    // from) has allocated nothing.
+    Node* head;
+    unsigned int levels;
+    unsigned int count;
+
+    template <typename Key>
+    const Node* last_less_than(const Key& key) const;
+
+    Node* insert_on_level(Node* left, const ElementType& element, bool& found);
+    const Node* head_of_level(unsigned int level) const noexcept;
+    template <typename RandomAccessIterator>
+    void build_even(RandomAccessIterator first, std::size_t size);
+    template <typename RandomAccessIterator>
+    void rebuild_even(RandomAccessIterator first, std::size_t size);
+
+    void destroy_all() noexcept;
+    void copy_from(const SkipListSet& s);
 };
 
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet()
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet()
     : SkipListSet{std::make_unique<RandomSkipListLevelTester<ElementType>>()}
 {
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
-    : levelTester{std::move(levelTester)}
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(std::unique_ptr<SkipListLevelTester<ElementType>> levelTester)
+    : levelTester{std::move(levelTester)}, head{nullptr}, levels{1}, count{0}
 {
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::~SkipListSet() noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::~SkipListSet() noexcept
 {
+    // A pool releases every node at once when it's destroyed, so the
+    // levels only need to be walked if the nodes have destructors to run.
+    if constexpr (!NodeAllocator<Node>::releasesInBulk || !std::is_trivially_destructible_v<Node>)
+    {
+        destroy_all();
+    }
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(const SkipListSet& s)
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(const SkipListSet& s)
+    : levelTester{s.levelTester != nullptr
+          ? s.levelTester->clone()
+          : std::make_unique<RandomSkipListLevelTester<ElementType>>()},
+      head{nullptr}, levels{1}, count{0}
 {
+    copy_from(s);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>::SkipListSet(SkipListSet&& s) noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>::SkipListSet(SkipListSet&& s) noexcept
+    : levelTester{std::move(s.levelTester)}, head{nullptr}, levels{1}, count{0}
 {
+    std::swap(head, s.head);
+    std::swap(levels, s.levels);
+    std::swap(count, s.count);
+    nodes.swap(s.nodes);
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(const SkipListSet& s)
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>& SkipListSet<ElementType, NodeAllocator>::operator=(const SkipListSet& s)
 {
+    if (this != &s)
+    {
+        SkipListSet copy{s};
+        *this = std::move(copy);
+    }
+
     return *this;
 }
 
 
-template <typename ElementType>
-SkipListSet<ElementType>& SkipListSet<ElementType>::operator=(SkipListSet&& s) noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+SkipListSet<ElementType, NodeAllocator>& SkipListSet<ElementType, NodeAllocator>::operator=(SkipListSet&& s) noexcept
 {
+    std::swap(levelTester, s.levelTester);
+    std::swap(head, s.head);
+    std::swap(levels, s.levels);
+    std::swap(count, s.count);
+    nodes.swap(s.nodes);
     return *this;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isImplemented() const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::isImplemented() const noexcept
 {
-    return false;
+    return true;
 }
 
 
-template <typename ElementType>
-void SkipListSet<ElementType>::add(const ElementType& element)
+template <typename ElementType, template <typename> typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::add(const ElementType& element)
 {
+    if (levelTester == nullptr)
+    {
+        levelTester = std::make_unique<RandomSkipListLevelTester<ElementType>>();
+    }
+
+    if (head == nullptr)
+    {
+        head = nodes.create(ElementType{}, nullptr, nullptr);
+    }
+
+    bool found = false;
+    Node* promoted = insert_on_level(head, element, found);
+
+    if (found)
+    {
+        return;
+    }
+
+    // An element that was promoted past the top level gets a new level of
+    // its own, for as long as the level tester keeps promoting it.
+    while (promoted != nullptr)
+    {
+        Node* node = nodes.create(element, nullptr, promoted);
+
+        try
+        {
+            head = nodes.create(ElementType{}, node, head);
+        }
+        catch (...)
+        {
+            nodes.destroy(node);
+            throw;
+        }
+
+        levels++;
+
+        promoted = levelTester->shouldOccupyNextLevel(element) ? node : nullptr;
+    }
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::contains(const ElementType& element) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename InputIterator>
+void SkipListSet<ElementType, NodeAllocator>::addSorted(InputIterator first, InputIterator last)
 {
-    return false;
+    using Category = typename std::iterator_traits<InputIterator>::iterator_category;
+
+    if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+    {
+        auto outOfOrder = [](const auto& a, const auto& b) { return !(a < b); };
+
+        if (count == 0 && std::adjacent_find(first, last, outOfOrder) == last)
+        {
+            rebuild_even(first, static_cast<std::size_t>(last - first));
+            return;
+        }
+    }
+
+    std::vector<ElementType> added(first, last);
+    std::sort(added.begin(), added.end());
+    added.erase(std::unique(added.begin(), added.end()), added.end());
+
+    // The elements already in the set are copied out of the bottom level,
+    // where they're in order, and merged with the new ones; equal elements
+    // are kept once.  The existing levels are left alone until the new
+    // ones have been built, so that the set is unchanged if anything along
+    // the way throws.
+    std::vector<ElementType> existing;
+    existing.reserve(count);
+
+    if (const Node* bottom = head_of_level(0))
+    {
+        for (const Node* n = bottom->next; n != nullptr; n = n->next)
+        {
+            existing.push_back(n->element);
+        }
+    }
+
+    std::vector<ElementType> merged;
+    merged.reserve(existing.size() + added.size());
+    std::set_union(
+        std::make_move_iterator(existing.begin()), std::make_move_iterator(existing.end()),
+        std::make_move_iterator(added.begin()), std::make_move_iterator(added.end()),
+        std::back_inserter(merged));
+
+    rebuild_even(std::make_move_iterator(merged.begin()), merged.size());
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::size() const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::contains(const ElementType& element) const
 {
-    return 0;
+    return containsKey(element);
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::levelCount() const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+bool SkipListSet<ElementType, NodeAllocator>::containsKey(const Key& key) const
 {
-    return 0;
+    const Node* left = last_less_than(key);
+    return left != nullptr && left->next != nullptr && left->next->element == key;
 }
 
 
-template <typename ElementType>
-unsigned int SkipListSet<ElementType>::elementsOnLevel(unsigned int level) const noexcept
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename InputIterator, typename OutputIterator>
+OutputIterator SkipListSet<ElementType, NodeAllocator>::containsSorted(
+    InputIterator first, InputIterator last, OutputIterator out) const
 {
-    return 0;
+    if (head == nullptr)
+    {
+        for (; first != last; ++first)
+        {
+            *out++ = false;
+        }
+
+        return out;
+    }
+
+    // left[k] is the last node on level k whose element is less than the
+    // previous key, which is also less than the next one, so any of them is
+    // a valid place to resume.  The search climbs from the bottom for as
+    // long as the next node on its level is still less than the key (and
+    // so would have to be walked past), then walks and descends as usual
+    // from there, updating left[] on the way down.
+    std::unique_ptr<const Node*[]> left{new const Node*[levels]};
+    const Node* n = head;
+
+    for (unsigned int level = levels; level-- > 0; n = n->down)
+    {
+        left[level] = n;
+    }
+
+    for (; first != last; ++first)
+    {
+        const auto& key = *first;
+        unsigned int level = 0;
+
+        while (level + 1 < levels && left[level]->next != nullptr && left[level]->next->element < key)
+        {
+            level++;
+        }
+
+        for (n = left[level]; ; n = n->down, level--)
+        {
+            while (n->next != nullptr && n->next->element < key)
+            {
+                n = n->next;
+            }
+
+            left[level] = n;
+
+            if (level == 0)
+            {
+                break;
+            }
+        }
+
+        *out++ = n->next != nullptr && n->next->element == key;
+    }
+
+    return out;
 }
 
 
-template <typename ElementType>
-bool SkipListSet<ElementType>::isElementOnLevel(const ElementType& element, unsigned int level) const
+template <typename ElementType, template <typename> typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::size() const noexcept
+{
+    return count;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::levelCount() const noexcept
+{
+    return levels;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+unsigned int SkipListSet<ElementType, NodeAllocator>::elementsOnLevel(unsigned int level) const noexcept
+{
+    unsigned int onLevel = 0;
+
+    if (const Node* left = head_of_level(level))
+    {
+        for (const Node* n = left->next; n != nullptr; n = n->next)
+        {
+            onLevel++;
+        }
+    }
+
+    return onLevel;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+bool SkipListSet<ElementType, NodeAllocator>::isElementOnLevel(const ElementType& element, unsigned int level) const
+{
+    if (head == nullptr || level >= levels)
+    {
+        return false;
+    }
+
+    // The search runs from the top level down to the given one, the same
+    // way contains() does, but stops there instead of at the bottom.
+    const Node* left = head;
+
+    for (unsigned int current = levels - 1; ; current--)
+    {
+        while (left->next != nullptr && left->next->element < element)
+        {
+            left = left->next;
+        }
+
+        if (current == level)
+        {
+            return left->next != nullptr && left->next->element == element;
+        }
+
+        left = left->down;
+    }
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Visitor>
+unsigned int SkipListSet<ElementType, NodeAllocator>::prefixScan(
+    std::string_view prefix, unsigned int limit, Visitor&& visit) const
+{
+    const Node* left = last_less_than(prefix);
+    unsigned int visited = 0;
+
+    if (left == nullptr)
+    {
+        return visited;
+    }
+
+    for (const Node* n = left->next; visited < limit && n != nullptr; n = n->next)
+    {
+        if (std::string_view{n->element}.substr(0, prefix.size()) != prefix)
+        {
+            break;
+        }
+
+        visit(n->element);
+        visited++;
+    }
+
+    return visited;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename Key>
+const typename SkipListSet<ElementType, NodeAllocator>::Node* SkipListSet<ElementType, NodeAllocator>::last_less_than(
+    const Key& key) const
+{
+    // Returns the node on the bottom level with the largest element less
+    // than the key (-INF if there isn't one), or nullptr if the set has
+    // never had an element added to it.
+    //
+    // The node that stops the search on one level is greater than or equal
+    // to the key, and so is the node below it, which stops the search on
+    // the level below without having to be compared to the key again.
+    // (On the top level, and below any level whose search reached +INF,
+    // the stopping point is +INF, i.e., nullptr.)
+    const Node* left = head;
+    const Node* stop = nullptr;
+
+    if (left == nullptr)
+    {
+        return nullptr;
+    }
+
+    while (true)
+    {
+        while (left->next != stop && left->next->element < key)
+        {
+            left = left->next;
+        }
+
+        if (left->down == nullptr)
+        {
+            return left;
+        }
+
+        stop = left->next != nullptr ? left->next->down : nullptr;
+        left = left->down;
+    }
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+typename SkipListSet<ElementType, NodeAllocator>::Node* SkipListSet<ElementType, NodeAllocator>::insert_on_level(
+    Node* left, const ElementType& element, bool& found)
 {
-    return false;
+    // Searches for the element on the level beginning at "left" and then
+    // on the levels below it.  If it's found, "found" is set and nothing
+    // is added; otherwise, it's added to the bottom level and then to each
+    // level above it for as long as the level tester says it should be.
+    // Returns the node added on this level if the element should also
+    // occupy the level above it, nullptr otherwise.
+    while (left->next != nullptr && left->next->element < element)
+    {
+        left = left->next;
+    }
+
+    if (left->next != nullptr && left->next->element == element)
+    {
+        found = true;
+        return nullptr;
+    }
+
+    Node* below = nullptr;
+
+    if (left->down != nullptr)
+    {
+        below = insert_on_level(left->down, element, found);
+
+        if (below == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    left->next = nodes.create(element, left->next, below);
+
+    // The element is in the set as soon as it's on the bottom level, so
+    // it's counted then; if promoting it any higher throws, it stays in
+    // the set (on fewer levels), and size() still agrees.
+    if (below == nullptr)
+    {
+        count++;
+    }
+
+    return levelTester->shouldOccupyNextLevel(element) ? left->next : nullptr;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+const typename SkipListSet<ElementType, NodeAllocator>::Node* SkipListSet<ElementType, NodeAllocator>::head_of_level(
+    unsigned int level) const noexcept
+{
+    if (head == nullptr || level >= levels)
+    {
+        return nullptr;
+    }
+
+    const Node* left = head;
+
+    for (unsigned int current = levels - 1; current > level; current--)
+    {
+        left = left->down;
+    }
+
+    return left;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename RandomAccessIterator>
+void SkipListSet<ElementType, NodeAllocator>::build_even(RandomAccessIterator first, std::size_t size)
+{
+    // The i-th element (counting from 1) is added to the end of the bottom
+    // level and then to the end of one more level for each time 2 divides
+    // i.  tails[k] is the last node on level k so far, which starts out
+    // as -INF; each level's -INF is created the first time it's needed.
+    // Each element is read from the range once (so it can be moved from),
+    // and copied from the node below it on the levels above the bottom.
+    // The set must be empty beforehand.
+    Node* tails[sizeof(std::size_t) * 8 + 1];
+
+    head = nodes.create(ElementType{}, nullptr, nullptr);
+    tails[0] = head;
+
+    try
+    {
+        for (std::size_t i = 1; i <= size; i++)
+        {
+            Node* below = nullptr;
+
+            for (unsigned int level = 0; level == 0 || i % (std::size_t{1} << level) == 0; level++)
+            {
+                if (level == levels)
+                {
+                    head = nodes.create(ElementType{}, nullptr, head);
+                    tails[level] = head;
+                    levels++;
+                }
+
+                tails[level]->next = below == nullptr
+                    ? nodes.create(first[i - 1], nullptr, nullptr)
+                    : nodes.create(below->element, nullptr, below);
+                tails[level] = tails[level]->next;
+                below = tails[level];
+            }
+
+            count++;
+        }
+    }
+    catch (...)
+    {
+        destroy_all();
+        throw;
+    }
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+template <typename RandomAccessIterator>
+void SkipListSet<ElementType, NodeAllocator>::rebuild_even(RandomAccessIterator first, std::size_t size)
+{
+    // The new levels are built in a SkipListSet of their own and only then
+    // swapped in (keeping this set's level tester), so if building them
+    // throws, this set is unchanged; the old levels are destroyed along
+    // with the other set.
+    SkipListSet rebuilt{std::unique_ptr<SkipListLevelTester<ElementType>>{}};
+    rebuilt.build_even(first, size);
+
+    std::swap(head, rebuilt.head);
+    std::swap(levels, rebuilt.levels);
+    std::swap(count, rebuilt.count);
+    nodes.swap(rebuilt.nodes);
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::destroy_all() noexcept
+{
+    Node* levelHead = head;
+
+    while (levelHead != nullptr)
+    {
+        Node* below = levelHead->down;
+
+        for (Node* n = levelHead; n != nullptr;)
+        {
+            Node* next = n->next;
+            nodes.destroy(n);
+            n = next;
+        }
+
+        levelHead = below;
+    }
+
+    head = nullptr;
+    levels = 1;
+    count = 0;
+}
+
+
+template <typename ElementType, template <typename> typename NodeAllocator>
+void SkipListSet<ElementType, NodeAllocator>::copy_from(const SkipListSet& s)
+{
+    // The copy has the same shape as the original: the levels are copied
+    // from the bottom up, and each copied node points down to the copy of
+    // the node its original points down to, which is found by walking the
+    // level below (in the original and the copy) in step with this one.
+    if (s.head == nullptr)
+    {
+        return;
+    }
+
+    std::unique_ptr<const Node*[]> sourceHeads{new const Node*[s.levels]};
+    const Node* sourceHead = s.head;
+
+    for (unsigned int level = s.levels; level-- > 0; sourceHead = sourceHead->down)
+    {
+        sourceHeads[level] = sourceHead;
+    }
+
+    Node* copiedBelow = nullptr;
+
+    try
+    {
+        for (unsigned int level = 0; level < s.levels; level++)
+        {
+            head = nodes.create(ElementType{}, nullptr, copiedBelow);
+            levels = level + 1;
+
+            Node* copiedLast = head;
+            const Node* sourceBelow = level > 0 ? sourceHeads[level - 1] : nullptr;
+            Node* down = copiedBelow;
+
+            for (const Node* n = sourceHeads[level]->next; n != nullptr; n = n->next)
+            {
+                if (sourceBelow != nullptr)
+                {
+                    while (sourceBelow != n->down)
+                    {
+                        sourceBelow = sourceBelow->next;
+                        down = down->next;
+                    }
+                }
+
+                copiedLast->next = nodes.create(n->element, nullptr, down);
+                copiedLast = copiedLast->next;
+            }
+
+            copiedBelow = head;
+        }
+    }
+    catch (...)
+    {
+        destroy_all();
+        throw;
+    }
+
+    levels = s.levels;
+    count = s.count;
 }
 
 
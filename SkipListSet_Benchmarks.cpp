@@ -0,0 +1,142 @@
+// SkipListSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing SkipListSet with the other node-based Set
+// implementations.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "AVLSet.hpp"
+#include "Benchmark.hpp"
+#include "HashSet.hpp"
+#include "NodePool.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // Adds the elements to a new set of the given type and then looks up
+    // a shuffled mix of the elements and the given missing ones, reporting
+    // the average cost of each add and lookup.
+    template <typename SetType, typename ElementType>
+    void measureSet(
+        const char* label, const std::vector<ElementType>& elements,
+        const std::vector<ElementType>& queries)
+    {
+        bench::Stopwatch watch;
+        SetType set;
+
+        for (const ElementType& element : elements)
+        {
+            set.add(element);
+        }
+
+        double addNs = bench::nanosPerOperation(watch, elements.size());
+
+        watch.restart();
+        unsigned int found = 0;
+
+        for (const ElementType& query : queries)
+        {
+            found += set.contains(query) ? 1 : 0;
+        }
+
+        double lookupNs = bench::nanosPerOperation(watch, queries.size());
+        bench::doNotOptimize(found);
+
+        std::printf("    %-20s add %7.1f ns  contains %7.1f ns\n", label, addNs, lookupNs);
+    }
+
+
+    template <typename ElementType>
+    void compareSets(
+        const char* label, const std::vector<ElementType>& elements,
+        const std::vector<ElementType>& missing)
+    {
+        std::vector<ElementType> queries = elements;
+        queries.insert(queries.end(), missing.begin(), missing.end());
+        std::shuffle(queries.begin(), queries.end(), std::mt19937{17});
+
+        std::printf("  %zu %s\n", elements.size(), label);
+        measureSet<SkipListSet<ElementType, HeapNodes>>("SkipListSet (heap)", elements, queries);
+        measureSet<SkipListSet<ElementType, NodePool>>("SkipListSet (pool)", elements, queries);
+        measureSet<AVLSet<ElementType>>("AVLSet", elements, queries);
+        measureSet<HashSet<ElementType>>("HashSet", elements, queries);
+    }
+}
+
+
+BENCHMARK(SkipListSet, versusAVLSetAndHashSet)
+{
+    for (unsigned int size : {10000u, 100000u, 1000000u})
+    {
+        std::vector<int> numbers;
+        std::vector<int> missingNumbers;
+        std::mt19937 engine{size};
+
+        for (unsigned int i = 0; i < size; ++i)
+        {
+            // Even numbers are in the set and odd numbers aren't.
+            numbers.push_back(static_cast<int>(engine() & ~1u));
+            missingNumbers.push_back(static_cast<int>(engine() | 1u));
+        }
+
+        compareSets("ints", numbers, missingNumbers);
+        compareSets("words", bench::makeWords(size, 18), bench::makeWords(size, 19));
+    }
+}
+
+
+BENCHMARK(SkipListSet, bulkLoad)
+{
+    for (unsigned int size : {31250u, 250000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 24);
+        std::sort(words.begin(), words.end());
+
+        std::vector<std::string> queries = bench::makeWords(size, 24);
+        std::vector<std::string> missing = bench::makeWords(size, 25);
+        queries.insert(queries.end(), missing.begin(), missing.end());
+        std::shuffle(queries.begin(), queries.end(), std::mt19937{26});
+
+        bench::Stopwatch watch;
+        SkipListSet<std::string> added;
+
+        for (const std::string& word : words)
+        {
+            added.add(word);
+        }
+
+        double addMs = watch.elapsedMilliseconds();
+        watch.restart();
+
+        SkipListSet<std::string> loaded;
+        loaded.addSorted(words.begin(), words.end());
+
+        double loadMs = watch.elapsedMilliseconds();
+
+        auto nanosPerLookup = [&](const SkipListSet<std::string>& set)
+        {
+            watch.restart();
+            unsigned int found = 0;
+
+            for (const std::string& query : queries)
+            {
+                found += set.contains(query) ? 1 : 0;
+            }
+
+            bench::doNotOptimize(found);
+            return bench::nanosPerOperation(watch, queries.size());
+        };
+
+        std::printf("  %7u words  add() %7.1f ms, %2u levels, contains %6.1f ns"
+            "  addSorted() %6.1f ms, %2u levels, contains %6.1f ns\n",
+            size, addMs, added.levelCount(), nanosPerLookup(added),
+            loadMs, loaded.levelCount(), nanosPerLookup(loaded));
+    }
+}
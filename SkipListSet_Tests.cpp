@@ -0,0 +1,545 @@
+// SkipListSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for SkipListSet beyond the provided sanity checks.
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "NodePool.hpp"
+#include "SkipListSet.hpp"
+
+
+namespace
+{
+    // Promotes an int once for each trailing zero bit it has (so 0 is
+    // never promoted), which makes the shape of the skip list depend only
+    // on which elements are in it.
+    class TrailingZerosLevelTester : public SkipListLevelTester<int>
+    {
+    public:
+        virtual bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element != current)
+            {
+                current = element;
+                flips = 0;
+            }
+
+            flips++;
+            return element != 0 && element % (1 << flips) == 0;
+        }
+
+        virtual std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<TrailingZerosLevelTester>();
+        }
+
+    private:
+        int current = -1;
+        int flips = 0;
+    };
+
+
+    std::unique_ptr<SkipListLevelTester<int>> trailingZeros()
+    {
+        return std::make_unique<TrailingZerosLevelTester>();
+    }
+
+
+    // Promotes elements as TrailingZerosLevelTester does, except that it
+    // throws instead when asked about the element given to it, so that an
+    // add() can be made to fail part-way through promoting that element.
+    class ThrowingLevelTester : public TrailingZerosLevelTester
+    {
+    public:
+        explicit ThrowingLevelTester(int throwOn)
+            : throwOn{throwOn}
+        {
+        }
+
+        virtual bool shouldOccupyNextLevel(const int& element) override
+        {
+            if (element == throwOn)
+            {
+                throw std::runtime_error{"level tester failed"};
+            }
+
+            return TrailingZerosLevelTester::shouldOccupyNextLevel(element);
+        }
+
+        virtual std::unique_ptr<SkipListLevelTester<int>> clone() override
+        {
+            return std::make_unique<ThrowingLevelTester>(throwOn);
+        }
+
+    private:
+        int throwOn;
+    };
+}
+
+
+namespace
+{
+    // An element whose copies start throwing once copiesLeft reaches zero,
+    // so that an operation can be made to fail part-way through.
+    struct Fragile
+    {
+        static int copiesLeft;
+
+        int value = 0;
+
+        Fragile() = default;
+
+        Fragile(int value)
+            : value{value}
+        {
+        }
+
+        Fragile(const Fragile& other)
+            : value{other.value}
+        {
+            if (copiesLeft == 0)
+            {
+                throw std::runtime_error{"copy failed"};
+            }
+
+            --copiesLeft;
+        }
+
+        Fragile& operator=(const Fragile& other) = default;
+
+        bool operator<(const Fragile& other) const { return value < other.value; }
+        bool operator==(const Fragile& other) const { return value == other.value; }
+    };
+
+    int Fragile::copiesLeft = -1;
+}
+
+
+TEST(SkipListSet_Tests, emptySetHasOneEmptyLevel)
+{
+    SkipListSet<int> s;
+
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(1, s.levelCount());
+    EXPECT_EQ(0, s.elementsOnLevel(0));
+    EXPECT_FALSE(s.contains(0));
+    EXPECT_FALSE(s.isElementOnLevel(0, 0));
+}
+
+
+TEST(SkipListSet_Tests, levelsFollowTheLevelTester)
+{
+    SkipListSet<int> s{trailingZeros()};
+
+    for (int i : {8, 3, 1, 6, 4, 7, 2, 5})
+    {
+        s.add(i);
+    }
+
+    EXPECT_EQ(8, s.size());
+    EXPECT_EQ(4, s.levelCount());
+    EXPECT_EQ(8, s.elementsOnLevel(0));
+    EXPECT_EQ(4, s.elementsOnLevel(1));
+    EXPECT_EQ(2, s.elementsOnLevel(2));
+    EXPECT_EQ(1, s.elementsOnLevel(3));
+    EXPECT_EQ(0, s.elementsOnLevel(4));
+
+    EXPECT_TRUE(s.isElementOnLevel(8, 3));
+    EXPECT_TRUE(s.isElementOnLevel(4, 2));
+    EXPECT_FALSE(s.isElementOnLevel(4, 3));
+    EXPECT_TRUE(s.isElementOnLevel(6, 1));
+    EXPECT_FALSE(s.isElementOnLevel(6, 2));
+    EXPECT_TRUE(s.isElementOnLevel(5, 0));
+    EXPECT_FALSE(s.isElementOnLevel(5, 1));
+    EXPECT_FALSE(s.isElementOnLevel(9, 0));
+}
+
+
+TEST(SkipListSet_Tests, addingAnElementAgainHasNoEffect)
+{
+    SkipListSet<int> s{trailingZeros()};
+
+    s.add(4);
+    s.add(4);
+    s.add(2);
+    s.add(4);
+
+    EXPECT_EQ(2, s.size());
+    EXPECT_EQ(3, s.levelCount());
+    EXPECT_EQ(2, s.elementsOnLevel(0));
+    EXPECT_EQ(1, s.elementsOnLevel(2));
+}
+
+
+TEST(SkipListSet_Tests, containsTheSameElementsAsAStdSet)
+{
+    std::mt19937 engine{46};
+    std::set<int> expected;
+    SkipListSet<int> s;
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int value = static_cast<int>(engine() % 50000);
+        expected.insert(value);
+        s.add(value);
+    }
+
+    EXPECT_EQ(expected.size(), s.size());
+    EXPECT_EQ(expected.size(), s.elementsOnLevel(0));
+
+    for (int i = 0; i < 50000; ++i)
+    {
+        EXPECT_EQ(expected.count(i) == 1, s.contains(i)) << i;
+    }
+}
+
+
+TEST(SkipListSet_Tests, copiesHaveTheSameShape)
+{
+    SkipListSet<int> original{trailingZeros()};
+
+    for (int i = 1; i <= 64; ++i)
+    {
+        original.add(i);
+    }
+
+    SkipListSet<int> copied{original};
+    SkipListSet<int> assigned;
+    assigned.add(1000);
+    assigned = original;
+
+    original.add(128);
+
+    for (const SkipListSet<int>* s : {&copied, &assigned})
+    {
+        EXPECT_EQ(64, s->size());
+        EXPECT_EQ(7, s->levelCount());
+
+        for (unsigned int level = 0; level < 7; ++level)
+        {
+            EXPECT_EQ(64u >> level, s->elementsOnLevel(level));
+        }
+
+        EXPECT_TRUE(s->isElementOnLevel(48, 4));
+        EXPECT_FALSE(s->contains(128));
+        EXPECT_FALSE(s->contains(1000));
+    }
+
+    // The copy has its own level tester, which promotes the same way.
+    copied.add(128);
+    EXPECT_EQ(8, copied.levelCount());
+    EXPECT_TRUE(copied.isElementOnLevel(128, 7));
+}
+
+
+TEST(SkipListSet_Tests, movesTakeTheElements)
+{
+    SkipListSet<std::string, HeapNodes> s;
+
+    for (int i = 0; i < 500; ++i)
+    {
+        s.add("WORD" + std::to_string(i));
+    }
+
+    SkipListSet<std::string, HeapNodes> moved{std::move(s)};
+    SkipListSet<std::string, HeapNodes> assigned;
+    assigned = std::move(moved);
+
+    EXPECT_EQ(500, assigned.size());
+    EXPECT_TRUE(assigned.contains("WORD0"));
+    EXPECT_TRUE(assigned.contains("WORD499"));
+    EXPECT_FALSE(assigned.contains("WORD500"));
+}
+
+
+TEST(SkipListSet_Tests, movedFromSetsCanStillBeUsed)
+{
+    SkipListSet<int> s;
+    s.add(1);
+
+    SkipListSet<int> moved{std::move(s)};
+    EXPECT_EQ(0, s.size());
+    EXPECT_FALSE(s.contains(1));
+
+    s.add(2);
+    s.add(3);
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.contains(2));
+
+    SkipListSet<int> copied{s};
+    copied.add(4);
+    EXPECT_EQ(3, copied.size());
+    EXPECT_TRUE(copied.contains(3));
+
+    EXPECT_EQ(1, moved.size());
+    EXPECT_TRUE(moved.contains(1));
+}
+
+
+TEST(SkipListSet_Tests, sizeCountsAnElementWhosePromotionThrew)
+{
+    SkipListSet<int> s{std::make_unique<ThrowingLevelTester>(8)};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        if (i == 8)
+        {
+            EXPECT_THROW(s.add(i), std::runtime_error);
+        }
+        else
+        {
+            s.add(i);
+        }
+    }
+
+    // 8 made it onto the bottom level before the level tester threw, so
+    // it's in the set, and counted.
+    EXPECT_EQ(10, s.size());
+    EXPECT_EQ(10, s.elementsOnLevel(0));
+    EXPECT_FALSE(s.isElementOnLevel(8, 1));
+    EXPECT_TRUE(s.contains(8));
+
+    s.add(8);
+    EXPECT_EQ(10, s.size());
+}
+
+
+TEST(SkipListSet_Tests, canLookUpStringsByView)
+{
+    SkipListSet<std::string> s;
+    s.add("HELLO");
+    s.add("THERE");
+    s.add("BOO");
+
+    std::string text = "BOOHELLOTHERE";
+    std::string_view view = text;
+    const StringViewLookup& lookup = s;
+
+    EXPECT_TRUE(lookup.containsView(view.substr(0, 3)));
+    EXPECT_TRUE(lookup.containsView(view.substr(3, 5)));
+    EXPECT_TRUE(lookup.containsView(view.substr(8)));
+    EXPECT_FALSE(lookup.containsView(view.substr(0, 4)));
+    EXPECT_FALSE(lookup.containsView(view.substr(0, 0)));
+}
+
+
+TEST(SkipListSet_Tests, prefixScanVisitsOnlyMatchingElementsInOrder)
+{
+    SkipListSet<std::string> s;
+
+    for (std::string word : {"CAT", "CATALOG", "CATS", "CAR", "DOG", "CA", "CB", "BAT", "CATERPILLAR"})
+    {
+        s.add(word);
+    }
+
+    const PrefixLookup& lookup = s;
+    std::vector<std::string> visited;
+    auto visit = [&](const std::string& w) { visited.push_back(w); };
+
+    EXPECT_EQ(4, lookup.visitPrefix("CAT", 10, visit));
+    EXPECT_EQ((std::vector<std::string>{"CAT", "CATALOG", "CATERPILLAR", "CATS"}), visited);
+
+    visited.clear();
+    EXPECT_EQ(2, s.prefixScan("CA", 2, visit));
+    EXPECT_EQ((std::vector<std::string>{"CA", "CAR"}), visited);
+
+    visited.clear();
+    EXPECT_EQ(0, s.prefixScan("CAX", 10, visit));
+    EXPECT_EQ(0, s.prefixScan("E", 10, visit));
+    EXPECT_EQ(0, SkipListSet<std::string>{}.prefixScan("", 10, visit));
+    EXPECT_TRUE(visited.empty());
+}
+
+
+TEST(SkipListSet_Tests, addSortedPromotesEveryPowerOfTwoth)
+{
+    std::vector<int> numbers;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        numbers.push_back(i * 3);
+    }
+
+    SkipListSet<int> s;
+    s.addSorted(numbers.begin(), numbers.end());
+
+    EXPECT_EQ(1000, s.size());
+    EXPECT_EQ(10, s.levelCount());
+
+    for (unsigned int level = 0; level < 10; ++level)
+    {
+        EXPECT_EQ(1000u >> level, s.elementsOnLevel(level));
+    }
+
+    // The 512th smallest element is the only one on the top level.
+    EXPECT_TRUE(s.isElementOnLevel(511 * 3, 9));
+    EXPECT_TRUE(s.isElementOnLevel(255 * 3, 8));
+    EXPECT_FALSE(s.isElementOnLevel(256 * 3, 1));
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        EXPECT_EQ(i % 3 == 0, s.contains(i)) << i;
+    }
+}
+
+
+TEST(SkipListSet_Tests, addSortedHandlesUnsortedInputAndDuplicates)
+{
+    std::vector<std::string> words{"PEAR", "APPLE", "FIG", "APPLE", "KIWI", "DATE", "FIG", "PLUM"};
+    SkipListSet<std::string> s;
+    s.addSorted(words.begin(), words.end());
+
+    EXPECT_EQ(6, s.size());
+    EXPECT_EQ(3, s.levelCount());
+    EXPECT_EQ(3, s.elementsOnLevel(1));
+    EXPECT_EQ(1, s.elementsOnLevel(2));
+    EXPECT_TRUE(s.isElementOnLevel("KIWI", 2));
+    EXPECT_TRUE(s.isElementOnLevel("PLUM", 1));
+
+    for (const std::string& word : words)
+    {
+        EXPECT_TRUE(s.contains(word));
+    }
+}
+
+
+TEST(SkipListSet_Tests, addSortedMergesWithExistingElements)
+{
+    SkipListSet<int> s{trailingZeros()};
+
+    for (int i = 1; i <= 10; ++i)
+    {
+        s.add(i * 2);
+    }
+
+    std::vector<int> odds;
+
+    for (int i = 0; i < 11; ++i)
+    {
+        odds.push_back(i * 2 + 1);
+    }
+
+    s.addSorted(odds.begin(), odds.end());
+
+    EXPECT_EQ(21, s.size());
+    EXPECT_EQ(5, s.levelCount());
+    EXPECT_EQ(10, s.elementsOnLevel(1));
+    EXPECT_EQ(1, s.elementsOnLevel(4));
+    EXPECT_TRUE(s.isElementOnLevel(16, 4));
+
+    for (int i = 1; i <= 21; ++i)
+    {
+        EXPECT_TRUE(s.contains(i)) << i;
+    }
+
+    // Later additions are promoted by the level tester again.
+    s.add(64);
+    EXPECT_EQ(7, s.levelCount());
+}
+
+
+TEST(SkipListSet_Tests, addSortedLeavesTheSetUnchangedWhenItFails)
+{
+    SkipListSet<Fragile> s;
+    Fragile sorted[] = {2, 4, 6, 8, 10, 12, 14};
+
+    // The set starts empty, so the levels are built straight from the
+    // range, and the failure comes part-way through building them.
+    Fragile::copiesLeft = 3;
+    EXPECT_THROW(s.addSorted(std::begin(sorted), std::end(sorted)), std::runtime_error);
+    EXPECT_EQ(0, s.size());
+    EXPECT_EQ(1, s.levelCount());
+    EXPECT_FALSE(s.contains(2));
+
+    Fragile::copiesLeft = -1;
+    s.add(5);
+    s.add(1);
+    s.add(9);
+    unsigned int levels = s.levelCount();
+
+    // The elements already in the set are merged with the new ones, and
+    // the failure comes part-way through copying and building them.
+    for (int copies = 0; copies < 20; ++copies)
+    {
+        Fragile::copiesLeft = copies;
+        EXPECT_THROW(s.addSorted(std::begin(sorted), std::end(sorted)), std::runtime_error);
+        Fragile::copiesLeft = -1;
+
+        EXPECT_EQ(3, s.size()) << copies;
+        EXPECT_EQ(3, s.elementsOnLevel(0)) << copies;
+        EXPECT_EQ(levels, s.levelCount()) << copies;
+
+        for (int i = 0; i <= 14; ++i)
+        {
+            EXPECT_EQ(i == 1 || i == 5 || i == 9, s.contains(i)) << copies << ' ' << i;
+        }
+    }
+
+    s.addSorted(std::begin(sorted), std::end(sorted));
+    EXPECT_EQ(10, s.size());
+    EXPECT_TRUE(s.contains(14));
+}
+
+
+TEST(SkipListSet_Tests, containsSortedAgreesWithContains)
+{
+    SkipListSet<int> s;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        s.add((i * 7919) % 6000);
+    }
+
+    std::vector<int> keys;
+
+    for (int i = -5; i < 6005; i += 1 + (i & 1))
+    {
+        keys.push_back(i);
+        keys.push_back(i);
+    }
+
+    std::vector<bool> found;
+    s.containsSorted(keys.begin(), keys.end(), std::back_inserter(found));
+
+    ASSERT_EQ(keys.size(), found.size());
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(s.contains(keys[i]), found[i]) << keys[i];
+    }
+}
+
+
+TEST(SkipListSet_Tests, containsSortedAcceptsViews)
+{
+    SkipListSet<std::string> empty;
+    SkipListSet<std::string> s;
+
+    for (std::string word : {"APPLE", "DATE", "FIG", "KIWI", "PEAR", "PLUM"})
+    {
+        s.add(word);
+    }
+
+    std::vector<std::string_view> keys{"A", "APPLE", "APPLE", "BANANA", "KIWI", "PLUM", "ZUCCHINI"};
+    bool found[7];
+
+    EXPECT_EQ(found + 7, s.containsSorted(keys.begin(), keys.end(), found));
+    EXPECT_EQ((std::vector<bool>{false, true, true, false, true, true, false}),
+        std::vector<bool>(found, found + 7));
+
+    empty.containsSorted(keys.begin(), keys.end(), found);
+    EXPECT_EQ(7, std::count(found, found + 7, false));
+}
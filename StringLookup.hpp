@@ -0,0 +1,107 @@
+// StringLookup.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Set<std::string>::contains() takes a const std::string&, so anyone who
+// has the characters of a word somewhere else (e.g., a piece of a larger
+// string) has to build a std::string before they can ask whether it's in
+// the set.  A StringViewLookup is an additional interface that a Set of
+// strings can offer, which lets it be asked about a std::string_view
+// instead, without building anything.
+//
+// Set implementations get this interface by deriving from
+// TransparentLookup<ElementType, Derived> and providing a public member
+// function template "containsKey(const Key& key) const" that can search
+// for any key comparable with their elements.  TransparentLookup only
+// adds StringViewLookup when ElementType is std::string; for any other
+// type, it's empty.
+//
+// Ordered sets of strings can also offer a PrefixLookup, which visits the
+// strings beginning with a given prefix, in order, without visiting the
+// rest of the set.  They get it by deriving from
+// OrderedLookup<ElementType, Derived> and providing a public member
+// function template "prefixScan(prefix, limit, visit) const".
+//
+// Code that only has a reference to a Set<std::string> can find out
+// whether the set offers these interfaces using dynamic_cast.
+
+#ifndef STRINGLOOKUP_HPP
+#define STRINGLOOKUP_HPP
+
+#include <functional>
+#include <string>
+#include <string_view>
+
+
+
+class StringViewLookup
+{
+public:
+    virtual ~StringViewLookup() = default;
+
+    // containsView() returns true if the set contains a string equal to
+    // the given view, false otherwise.
+    virtual bool containsView(std::string_view element) const = 0;
+};
+
+
+
+template <typename ElementType, typename Derived>
+class TransparentLookup
+{
+};
+
+
+template <typename Derived>
+class TransparentLookup<std::string, Derived> : public StringViewLookup
+{
+public:
+    virtual bool containsView(std::string_view element) const override
+    {
+        return static_cast<const Derived*>(this)->containsKey(element);
+    }
+};
+
+
+
+class PrefixLookup
+{
+public:
+    // A PrefixVisitor is a function that takes a reference to a const
+    // std::string and returns no value.
+    using PrefixVisitor = std::function<void(const std::string&)>;
+
+    virtual ~PrefixLookup() = default;
+
+    // visitPrefix() calls the given "visit" function for each string in
+    // the set that begins with the given prefix, in ascending order,
+    // stopping after it has visited "limit" of them.  It returns the
+    // number of strings visited.
+    virtual unsigned int visitPrefix(
+        std::string_view prefix, unsigned int limit, const PrefixVisitor& visit) const = 0;
+};
+
+
+
+template <typename ElementType, typename Derived>
+class OrderedLookup
+{
+};
+
+
+template <typename Derived>
+class OrderedLookup<std::string, Derived> : public PrefixLookup
+{
+public:
+    virtual unsigned int visitPrefix(
+        std::string_view prefix, unsigned int limit, const PrefixVisitor& visit) const override
+    {
+        return static_cast<const Derived*>(this)->prefixScan(prefix, limit, visit);
+    }
+};
+
+
+
+#endif // STRINGLOOKUP_HPP
+
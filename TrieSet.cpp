@@ -0,0 +1,437 @@
+// TrieSet.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include "TrieSet.hpp"
+#include "Hashing.hpp"
+
+
+namespace
+{
+    constexpr std::uint32_t NONE = 0xffffffffu;
+    constexpr std::uint64_t EMPTY = ~std::uint64_t{0};
+    constexpr std::uint32_t DEFAULT_CAPACITY = 16;
+}
+
+
+TrieSet::TrieSet()
+    : nodes{new Node[DEFAULT_CAPACITY]}, used{1}, total_capacity{DEFAULT_CAPACITY},
+      total_size{0}, minimized{false}
+{
+    nodes[0] = Node{0, 0};
+}
+
+
+TrieSet::~TrieSet() noexcept
+{
+    delete[] nodes;
+}
+
+
+TrieSet::TrieSet(const TrieSet& s)
+    : nodes{s.nodes != nullptr ? new Node[s.total_capacity] : nullptr},
+      used{s.used}, total_capacity{s.total_capacity},
+      total_size{s.total_size}, minimized{s.minimized}
+{
+    std::copy(s.nodes, s.nodes + s.used, nodes);
+}
+
+
+TrieSet::TrieSet(TrieSet&& s) noexcept
+    : nodes{nullptr}, used{0}, total_capacity{0}, total_size{0}, minimized{false}
+{
+    std::swap(nodes, s.nodes);
+    std::swap(used, s.used);
+    std::swap(total_capacity, s.total_capacity);
+    std::swap(total_size, s.total_size);
+    std::swap(minimized, s.minimized);
+}
+
+
+TrieSet& TrieSet::operator=(const TrieSet& s)
+{
+    if (this != &s)
+    {
+        Node* copied = s.nodes != nullptr ? new Node[s.total_capacity] : nullptr;
+        std::copy(s.nodes, s.nodes + s.used, copied);
+
+        delete[] nodes;
+        nodes = copied;
+        used = s.used;
+        total_capacity = s.total_capacity;
+        total_size = s.total_size;
+        minimized = s.minimized;
+    }
+
+    return *this;
+}
+
+
+TrieSet& TrieSet::operator=(TrieSet&& s) noexcept
+{
+    std::swap(nodes, s.nodes);
+    std::swap(used, s.used);
+    std::swap(total_capacity, s.total_capacity);
+    std::swap(total_size, s.total_size);
+    std::swap(minimized, s.minimized);
+    return *this;
+}
+
+
+bool TrieSet::isImplemented() const noexcept
+{
+    return true;
+}
+
+
+void TrieSet::add(const std::string& element)
+{
+    for (char c : element)
+    {
+        if (c < 'A' || c > 'Z')
+        {
+            throw std::invalid_argument{"TrieSet can only contain the letters A through Z"};
+        }
+    }
+
+    if (contains(element))
+    {
+        return;
+    }
+
+    if (nodes == nullptr)
+    {
+        nodes = new Node[DEFAULT_CAPACITY];
+        nodes[0] = Node{0, 0};
+        used = 1;
+        total_capacity = DEFAULT_CAPACITY;
+    }
+
+    // Indexes are used throughout, rather than pointers or references,
+    // because allocate() may move the nodes.
+    std::uint32_t current = 0;
+
+    for (char c : element)
+    {
+        unsigned int letter = static_cast<unsigned int>(c - 'A');
+        std::uint32_t mask = nodes[current].mask;
+        std::uint32_t count = child_count(mask);
+        std::uint32_t offset = child_offset(mask, letter);
+        std::uint32_t first = nodes[current].firstChild;
+
+        if (mask & (1u << letter))
+        {
+            // After minimize(), the children may be shared with other
+            // nodes, so they're copied before anything below them changes.
+            if (minimized)
+            {
+                std::uint32_t block = allocate(count);
+                std::copy(nodes + first, nodes + first + count, nodes + block);
+                nodes[current].firstChild = block;
+                first = block;
+            }
+        }
+        else
+        {
+            // The children are moved to the end of the array, making room
+            // for the new one in its place in letter order.
+            std::uint32_t block = allocate(count + 1);
+            std::copy(nodes + first, nodes + first + offset, nodes + block);
+            nodes[block + offset] = Node{0, 0};
+            std::copy(nodes + first + offset, nodes + first + count, nodes + block + offset + 1);
+            nodes[current].mask |= 1u << letter;
+            nodes[current].firstChild = block;
+            first = block;
+        }
+
+        current = first + offset;
+    }
+
+    nodes[current].mask |= TERMINAL;
+    total_size++;
+}
+
+
+bool TrieSet::contains(const std::string& element) const
+{
+    return containsView(element);
+}
+
+
+bool TrieSet::containsView(std::string_view element) const
+{
+    std::uint32_t n = find_node(element);
+    return n != NONE && (nodes[n].mask & TERMINAL) != 0;
+}
+
+
+unsigned int TrieSet::size() const noexcept
+{
+    return total_size;
+}
+
+
+void TrieSet::minimize()
+{
+    // The nodes are rebuilt into a new array from the bottom up.  Two nodes
+    // have the same set of suffixes exactly when they have the same mask
+    // and their children (in order) have the same sets of suffixes, so
+    // once the children of a node have been rebuilt, its block of children
+    // can be looked up in a table of the blocks built so far, and shared if
+    // it's there already.
+    if (nodes == nullptr)
+    {
+        return;
+    }
+
+    Node* out = new Node[used];
+    std::uint32_t outUsed = 1;
+
+    std::uint32_t* memo = new std::uint32_t[used];
+    std::fill(memo, memo + used, NONE);
+
+    std::uint32_t tableSize = 16;
+
+    while (tableSize < used * 2)
+    {
+        tableSize *= 2;
+    }
+
+    // Each entry in the table is a block's size and its index in the new
+    // array.
+    std::uint64_t* table = new std::uint64_t[tableSize];
+    std::fill(table, table + tableSize, EMPTY);
+
+    out[0] = Node{nodes[0].mask,
+        canonical_block(nodes[0].firstChild, nodes[0].mask, out, outUsed, memo, table, tableSize - 1)};
+
+    delete[] table;
+    delete[] memo;
+
+    Node* compacted = new Node[std::max(outUsed, DEFAULT_CAPACITY)];
+    std::copy(out, out + outUsed, compacted);
+    delete[] out;
+
+    delete[] nodes;
+    nodes = compacted;
+    used = outUsed;
+    total_capacity = std::max(outUsed, DEFAULT_CAPACITY);
+    minimized = true;
+}
+
+
+unsigned int TrieSet::nodeCount() const noexcept
+{
+    return used;
+}
+
+
+std::size_t TrieSet::memoryUsage() const noexcept
+{
+    return std::size_t{total_capacity} * sizeof(Node);
+}
+
+
+std::vector<std::string> TrieSet::findSuggestions(std::string_view word, unsigned int maxDistance) const
+{
+    // rows holds one row of the edit distance table for each node on the
+    // path from the root to the node being visited: entry j of the row at
+    // depth d is the distance between the first j characters of the word
+    // and the d-letter prefix spelled by the path.  No prefix longer than
+    // the word plus maxDistance can be close enough, so that's as deep as
+    // the walk goes.
+    if (nodes == nullptr)
+    {
+        return {};
+    }
+
+    std::size_t width = word.size() + 1;
+    std::size_t depth = word.size() + maxDistance + 1;
+    std::vector<unsigned int> rows(width * (depth + 1));
+    std::vector<std::pair<unsigned int, std::string>> found;
+    std::string prefix;
+
+    for (std::size_t j = 0; j < width; ++j)
+    {
+        rows[j] = static_cast<unsigned int>(j);
+    }
+
+    if ((nodes[0].mask & TERMINAL) && rows[width - 1] <= maxDistance)
+    {
+        found.emplace_back(rows[width - 1], prefix);
+    }
+
+    auto visit = [&](auto& self, std::uint32_t n, std::size_t d) -> void
+    {
+        const unsigned int* above = &rows[(d - 1) * width];
+        unsigned int* row = &rows[d * width];
+        std::uint32_t mask = nodes[n].mask & LETTERS;
+        std::uint32_t child = nodes[n].firstChild;
+
+        for (; mask != 0; mask &= mask - 1, ++child)
+        {
+            char c = static_cast<char>('A' + __builtin_ctz(mask));
+            unsigned int best = row[0] = above[0] + 1;
+
+            for (std::size_t j = 1; j < width; ++j)
+            {
+                row[j] = std::min({above[j] + 1, row[j - 1] + 1,
+                    above[j - 1] + (word[j - 1] == c ? 0u : 1u)});
+                best = std::min(best, row[j]);
+            }
+
+            if (best > maxDistance)
+            {
+                continue;
+            }
+
+            prefix.push_back(c);
+
+            if ((nodes[child].mask & TERMINAL) && row[width - 1] <= maxDistance)
+            {
+                found.emplace_back(row[width - 1], prefix);
+            }
+
+            if (d < depth)
+            {
+                self(self, child, d + 1);
+            }
+
+            prefix.pop_back();
+        }
+    };
+
+    visit(visit, 0, 1);
+
+    // The walk visits the words in alphabetical order, so a stable sort by
+    // distance leaves each distance's words in alphabetical order.
+    std::stable_sort(found.begin(), found.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<std::string> suggestions;
+    suggestions.reserve(found.size());
+
+    for (auto& f : found)
+    {
+        suggestions.push_back(std::move(f.second));
+    }
+
+    return suggestions;
+}
+
+
+std::uint32_t TrieSet::allocate(std::uint32_t count)
+{
+    if (used + count > total_capacity)
+    {
+        std::uint32_t newCapacity = total_capacity * 2;
+
+        while (used + count > newCapacity)
+        {
+            newCapacity *= 2;
+        }
+
+        Node* grown = new Node[newCapacity];
+        std::copy(nodes, nodes + used, grown);
+        delete[] nodes;
+        nodes = grown;
+        total_capacity = newCapacity;
+    }
+
+    std::uint32_t block = used;
+    used += count;
+    return block;
+}
+
+
+std::uint32_t TrieSet::find_node(std::string_view element) const noexcept
+{
+    if (nodes == nullptr)
+    {
+        return NONE;
+    }
+
+    std::uint32_t current = 0;
+
+    for (char c : element)
+    {
+        unsigned int letter = static_cast<unsigned int>(c - 'A');
+
+        if (letter >= 26 || (nodes[current].mask & (1u << letter)) == 0)
+        {
+            return NONE;
+        }
+
+        current = nodes[current].firstChild + child_offset(nodes[current].mask, letter);
+    }
+
+    return current;
+}
+
+
+std::uint32_t TrieSet::canonical_block(
+    std::uint32_t firstChild, std::uint32_t mask, Node* out, std::uint32_t& outUsed,
+    std::uint32_t* memo, std::uint64_t* table, std::uint32_t tableMask) const
+{
+    std::uint32_t count = child_count(mask);
+
+    if (count == 0)
+    {
+        return 0;
+    }
+    else if (memo[firstChild] != NONE)
+    {
+        return memo[firstChild];
+    }
+
+    Node block[26];
+    std::uint64_t hash = count;
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const Node& child = nodes[firstChild + i];
+        block[i] = Node{child.mask,
+            canonical_block(child.firstChild, child.mask, out, outUsed, memo, table, tableMask)};
+        hash = hashing::mix64(hash ^ ((std::uint64_t{block[i].mask} << 32) | block[i].firstChild));
+    }
+
+    std::uint32_t slot = static_cast<std::uint32_t>(hash) & tableMask;
+
+    for (; table[slot] != EMPTY; slot = (slot + 1) & tableMask)
+    {
+        std::uint32_t existing = static_cast<std::uint32_t>(table[slot]);
+
+        if ((table[slot] >> 32) == count
+            && std::equal(block, block + count, out + existing,
+                   [](const Node& a, const Node& b)
+                   { return a.mask == b.mask && a.firstChild == b.firstChild; }))
+        {
+            memo[firstChild] = existing;
+            return existing;
+        }
+    }
+
+    std::uint32_t start = outUsed;
+    std::copy(block, block + count, out + start);
+    outUsed += count;
+    table[slot] = (std::uint64_t{count} << 32) | start;
+    memo[firstChild] = start;
+    return start;
+}
+
+
+std::uint32_t TrieSet::child_count(std::uint32_t mask) noexcept
+{
+    return static_cast<std::uint32_t>(__builtin_popcount(mask & LETTERS));
+}
+
+
+std::uint32_t TrieSet::child_offset(std::uint32_t mask, unsigned int letter) noexcept
+{
+    return static_cast<std::uint32_t>(__builtin_popcount(mask & ((1u << letter) - 1)));
+}
+
@@ -0,0 +1,154 @@
+// TrieSet.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A TrieSet is an implementation of a Set of strings that is a trie over
+// the letters 'A' through 'Z', which are the only characters WordChecker
+// ever puts into a word.  Each node represents a prefix of one or more of
+// the words in the set, and knows whether that prefix is itself a word.
+//
+// A node is only eight bytes: a 26-bit mask saying which letters it has
+// children for (plus one more bit saying whether it ends a word), and the
+// index of the first of its children.  A node's children are stored next
+// to one another in letter order, so the child for a given letter is found
+// by counting the bits in the mask below that letter; there is no searching
+// through lists of children.  (Adding a child to a node moves its children
+// to the end of the array, leaving the old ones behind until the next time
+// minimize() is called.)
+//
+// minimize() turns the trie into a DAWG (directed acyclic word graph) by
+// merging all of the nodes whose sets of suffixes are the same, e.g., the
+// "ING" at the end of every word ending in "ING" is stored only once.  The
+// set can still be added to afterward; the nodes along the path of an
+// added word are copied first, so that the words sharing them aren't
+// affected.
+//
+// Because all of the words sharing a prefix share the path to it, the trie
+// can also find every word within a given edit distance of a query in one
+// walk, computing one row of the edit distance table per node.  This is
+// equivalent to running a Levenshtein automaton for the query alongside
+// the trie: any subtree whose row has no entry within the distance can't
+// contain a match, so it's skipped.
+//
+// As with the other Set implementations, the nodes are stored in a
+// dynamically-allocated array rather than a standard container.
+
+#ifndef TRIESET_HPP
+#define TRIESET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+
+class TrieSet : public Set<std::string>, public StringViewLookup
+{
+public:
+    // Initializes a TrieSet to be empty.
+    TrieSet();
+
+    // Cleans up the TrieSet so that it leaks no memory.
+    virtual ~TrieSet() noexcept;
+
+    // Initializes a new TrieSet to be a copy of an existing one.
+    TrieSet(const TrieSet& s);
+
+    // Initializes a new TrieSet whose contents are moved from an
+    // expiring one.
+    TrieSet(TrieSet&& s) noexcept;
+
+    // Assigns an existing TrieSet into another.
+    TrieSet& operator=(const TrieSet& s);
+
+    // Assigns an expiring TrieSet into another.
+    TrieSet& operator=(TrieSet&& s) noexcept;
+
+
+    virtual bool isImplemented() const noexcept override;
+
+
+    // add() adds an element to the set.  If the element is already in the
+    // set, this function has no effect.  Only words made up of the letters
+    // 'A' through 'Z' can be added; adding any other word throws a
+    // std::invalid_argument.  This function runs in time proportional to
+    // the length of the word.
+    virtual void add(const std::string& element) override;
+
+
+    // contains() returns true if the given element is already in the set,
+    // false otherwise.  This function runs in time proportional to the
+    // length of the word.
+    virtual bool contains(const std::string& element) const override;
+
+
+    virtual bool containsView(std::string_view element) const override;
+
+
+    // size() returns the number of elements in the set.
+    virtual unsigned int size() const noexcept override;
+
+
+    // minimize() merges every group of nodes with the same set of suffixes
+    // into one node, and discards any nodes left behind by add().  It runs
+    // in time proportional to the number of nodes.
+    void minimize();
+
+
+    // nodeCount() returns the number of nodes in the trie (or DAWG),
+    // including any that add() has left behind.
+    unsigned int nodeCount() const noexcept;
+
+
+    // memoryUsage() returns the number of bytes used to store the nodes.
+    std::size_t memoryUsage() const noexcept;
+
+
+    // findSuggestions() returns every word in the set whose Levenshtein
+    // distance from the given word is at most maxDistance, ordered by
+    // their distance and then alphabetically.
+    std::vector<std::string> findSuggestions(std::string_view word, unsigned int maxDistance) const;
+
+
+private:
+    // The low 26 bits of mask say which letters a node has children for;
+    // TERMINAL says whether the node ends a word.  The node's children are
+    // nodes[firstChild], nodes[firstChild + 1], and so on, one per bit set
+    // in the low 26 bits of the mask, in letter order.  The root is always
+    // nodes[0].  A TrieSet that's been moved from (or copied from one that
+    // has) has no nodes at all, not even a root, so that moving never
+    // allocates; the root is created when a word is next added.
+    struct Node
+    {
+        std::uint32_t mask;
+        std::uint32_t firstChild;
+    };
+
+    static constexpr std::uint32_t LETTERS = (1u << 26) - 1;
+    static constexpr std::uint32_t TERMINAL = 1u << 31;
+
+    Node* nodes;
+    std::uint32_t used;
+    std::uint32_t total_capacity;
+    unsigned int total_size;
+    bool minimized;
+
+    std::uint32_t allocate(std::uint32_t count);
+    std::uint32_t find_node(std::string_view element) const noexcept;
+    std::uint32_t canonical_block(
+        std::uint32_t firstChild, std::uint32_t mask, Node* out, std::uint32_t& outUsed,
+        std::uint32_t* memo, std::uint64_t* table, std::uint32_t tableMask) const;
+
+    static std::uint32_t child_count(std::uint32_t mask) noexcept;
+    static std::uint32_t child_offset(std::uint32_t mask, unsigned int letter) noexcept;
+};
+
+
+
+#endif // TRIESET_HPP
+
@@ -0,0 +1,96 @@
+// TrieSet_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks comparing TrieSet with HashSet.
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "HashSet.hpp"
+#include "TrieSet.hpp"
+
+
+namespace
+{
+    // Looks up every word along with the same number of words that aren't
+    // in the set, printing the memory held per word (as measured by the
+    // caller) and the lookup rates.
+    template <typename SetType>
+    void measureLookups(
+        const char* label, const SetType& set, std::size_t bytes,
+        const std::vector<std::string>& words,
+        const std::vector<std::string>& missing)
+    {
+        bench::Stopwatch watch;
+        unsigned int found = 0;
+
+        for (const std::string& word : words)
+        {
+            found += set.contains(word) ? 1 : 0;
+        }
+
+        double hitNs = bench::nanosPerOperation(watch, words.size());
+        watch.restart();
+
+        for (const std::string& word : missing)
+        {
+            found += set.contains(word) ? 1 : 0;
+        }
+
+        double missNs = bench::nanosPerOperation(watch, missing.size());
+        bench::doNotOptimize(found);
+
+        std::printf("  %-18s %7.1f bytes/word  hit %6.1f ns (%5.1f M/s)  miss %6.1f ns (%5.1f M/s)\n",
+            label, static_cast<double>(bytes) / words.size(),
+            hitNs, 1000.0 / hitNs, missNs, 1000.0 / missNs);
+    }
+}
+
+
+BENCHMARK(TrieSet, memoryAndLookups)
+{
+    for (unsigned int size : {100000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 9);
+        std::vector<std::string> missing = bench::makeWords(size, 10);
+
+        std::printf("  %u words\n", size);
+
+        {
+            std::size_t before = bench::liveBytes();
+            HashSet<std::string> set;
+
+            for (const std::string& word : words)
+            {
+                set.add(word);
+            }
+
+            measureLookups("HashSet", set, bench::liveBytes() - before, words, missing);
+        }
+
+        std::size_t before = bench::liveBytes();
+        bench::Stopwatch watch;
+        TrieSet trie;
+
+        for (const std::string& word : words)
+        {
+            trie.add(word);
+        }
+
+        double buildMs = watch.elapsedMilliseconds();
+        measureLookups("TrieSet", trie, bench::liveBytes() - before, words, missing);
+
+        unsigned int trieNodes = trie.nodeCount();
+        watch.restart();
+        trie.minimize();
+        double minimizeMs = watch.elapsedMilliseconds();
+        measureLookups("TrieSet (DAWG)", trie, bench::liveBytes() - before, words, missing);
+
+        std::printf("  build %.1f ms  minimize %.1f ms  nodes %u -> %u\n",
+            buildMs, minimizeMs, trieNodes, trie.nodeCount());
+    }
+}
+
@@ -0,0 +1,231 @@
+// TrieSet_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for TrieSet.
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "BKTree.hpp"
+#include "TrieSet.hpp"
+#include "WordChecker.hpp"
+
+
+namespace
+{
+    std::string randomWord(std::mt19937& engine, unsigned int minLength, unsigned int maxLength)
+    {
+        std::uniform_int_distribution<unsigned int> length{minLength, maxLength};
+        std::uniform_int_distribution<int> letter{'A', 'D'};
+        std::string word(length(engine), ' ');
+
+        for (char& c : word)
+        {
+            c = static_cast<char>(letter(engine));
+        }
+
+        return word;
+    }
+}
+
+
+TEST(TrieSet_Tests, containsOnlyTheWordsAdded)
+{
+    TrieSet s;
+    s.add("CAT");
+    s.add("CATS");
+    s.add("CAR");
+    s.add("CAT");
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains("CAT"));
+    EXPECT_TRUE(s.contains("CATS"));
+    EXPECT_TRUE(s.contains("CAR"));
+    EXPECT_FALSE(s.contains("CA"));
+    EXPECT_FALSE(s.contains("CATSS"));
+    EXPECT_FALSE(s.contains("DOG"));
+    EXPECT_FALSE(s.contains(""));
+    EXPECT_FALSE(s.contains("cat"));
+}
+
+
+TEST(TrieSet_Tests, canContainTheEmptyWord)
+{
+    TrieSet s;
+    s.add("");
+
+    EXPECT_EQ(1, s.size());
+    EXPECT_TRUE(s.contains(""));
+}
+
+
+TEST(TrieSet_Tests, rejectsCharactersOtherThanLetters)
+{
+    TrieSet s;
+
+    EXPECT_THROW(s.add("CAT DOG"), std::invalid_argument);
+    EXPECT_THROW(s.add("cat"), std::invalid_argument);
+    EXPECT_EQ(0, s.size());
+}
+
+
+TEST(TrieSet_Tests, minimizingSharesCommonSuffixes)
+{
+    TrieSet s;
+
+    for (std::string prefix : {"JUMP", "WALK", "TALK", "PLAY"})
+    {
+        for (std::string suffix : {"", "S", "ED", "ING"})
+        {
+            s.add(prefix + suffix);
+        }
+    }
+
+    unsigned int before = s.nodeCount();
+    s.minimize();
+
+    EXPECT_LT(s.nodeCount(), before / 2);
+    EXPECT_EQ(16, s.size());
+
+    for (std::string prefix : {"JUMP", "WALK", "TALK", "PLAY"})
+    {
+        for (std::string suffix : {"", "S", "ED", "ING"})
+        {
+            EXPECT_TRUE(s.contains(prefix + suffix));
+        }
+
+        EXPECT_FALSE(s.contains(prefix + "ER"));
+    }
+}
+
+
+TEST(TrieSet_Tests, addingAfterMinimizingLeavesOtherWordsAlone)
+{
+    TrieSet s;
+    s.add("WALKED");
+    s.add("TALKED");
+    s.minimize();
+
+    // The "ED" is shared by both words; adding "WALKER" mustn't add
+    // "TALKER" too.
+    s.add("WALKER");
+
+    EXPECT_EQ(3, s.size());
+    EXPECT_TRUE(s.contains("WALKER"));
+    EXPECT_FALSE(s.contains("TALKER"));
+    EXPECT_TRUE(s.contains("TALKED"));
+}
+
+
+TEST(TrieSet_Tests, randomWordsSurviveMinimizingAndCopying)
+{
+    std::mt19937 engine{46};
+    std::vector<std::string> words;
+    TrieSet s;
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string word = randomWord(engine, 0, 10);
+        words.push_back(word);
+        s.add(word);
+
+        if (i % 1000 == 999)
+        {
+            s.minimize();
+        }
+    }
+
+    TrieSet copy = s;
+    std::sort(words.begin(), words.end());
+    words.erase(std::unique(words.begin(), words.end()), words.end());
+
+    EXPECT_EQ(words.size(), copy.size());
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string word = randomWord(engine, 0, 10);
+        EXPECT_EQ(std::binary_search(words.begin(), words.end(), word), copy.contains(word)) << word;
+    }
+}
+
+
+TEST(TrieSet_Tests, movedFromSetIsStillUsable)
+{
+    TrieSet s1;
+    s1.add("CAT");
+
+    TrieSet s2{std::move(s1)};
+    EXPECT_TRUE(s2.contains("CAT"));
+
+    EXPECT_EQ(0, s1.size());
+    EXPECT_FALSE(s1.contains("CAT"));
+    EXPECT_FALSE(s1.contains(""));
+    EXPECT_TRUE(s1.findSuggestions("CAT", 2).empty());
+    s1.minimize();
+
+    TrieSet copied{s1};
+    TrieSet assigned;
+    assigned.add("DOG");
+    assigned = s1;
+    EXPECT_FALSE(assigned.contains("DOG"));
+
+    for (TrieSet* s : {&s1, &copied, &assigned})
+    {
+        s->add("CAR");
+        s->add("CART");
+        EXPECT_EQ(2, s->size());
+        EXPECT_TRUE(s->contains("CART"));
+        EXPECT_FALSE(s->contains("CA"));
+        EXPECT_EQ((std::vector<std::string>{"CAR", "CART"}), s->findSuggestions("CAR", 1));
+    }
+}
+
+
+TEST(TrieSet_Tests, findsTheSameSuggestionsAsABKTree)
+{
+    std::mt19937 engine{2018};
+    std::vector<std::string> words;
+    TrieSet s;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        words.push_back(randomWord(engine, 1, 8));
+        s.add(words.back());
+    }
+
+    BKTree tree{words};
+    TrieSet minimized = s;
+    minimized.minimize();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string query = randomWord(engine, 0, 9);
+
+        for (unsigned int k = 0; k <= 2; ++k)
+        {
+            EXPECT_EQ(tree.findSuggestions(query, k), s.findSuggestions(query, k)) << query << " " << k;
+            EXPECT_EQ(tree.findSuggestions(query, k), minimized.findSuggestions(query, k)) << query << " " << k;
+        }
+    }
+}
+
+
+TEST(TrieSet_Tests, canBeUsedByAWordChecker)
+{
+    TrieSet s;
+    s.add("CAT");
+    s.add("CART");
+    s.minimize();
+
+    WordChecker checker{s};
+
+    EXPECT_TRUE(checker.wordExists("CAT"));
+    EXPECT_FALSE(checker.wordExists("CAR"));
+}
+
@@ -6,14 +6,101 @@
 // Replace and/or augment the implementations below as needed to meet
 // the requirements.
 
+#include <algorithm>
 #include <iostream>
+#include "Hashing.hpp"
 #include "WordChecker.hpp"
+#include "WorkStealingPool.hpp"
 #include <vector>
 using namespace std;
 
 
+namespace
+{
+    // A SuggestionCollector appends suggestions to a vector, skipping the
+    // ones that have already been appended.  Rather than searching the
+    // vector each time, it remembers what it has appended in a small
+    // open-addressed hash table of indexes into the vector, so checking
+    // for a duplicate takes constant time no matter how many suggestions
+    // there are.  The table isn't allocated until the first suggestion is
+    // appended, since most words have few (or no) suggestions.
+    class SuggestionCollector
+    {
+    public:
+        explicit SuggestionCollector(vector<string>& suggestions)
+            : suggestions{suggestions}
+        {
+        }
+
+        void add(string_view suggestion)
+        {
+            if (slots.empty())
+            {
+                slots.resize(16);
+            }
+            else if ((suggestions.size() + 1) * 2 > slots.size())
+            {
+                grow();
+            }
+
+            unsigned int hash = DefaultHash<string>{}(suggestion);
+            size_t mask = slots.size() - 1;
+
+            for (size_t i = hash & mask; ; i = (i + 1) & mask)
+            {
+                if (slots[i].index == 0)
+                {
+                    suggestions.emplace_back(suggestion);
+                    slots[i] = Slot{hash, static_cast<unsigned int>(suggestions.size())};
+                    return;
+                }
+                else if (slots[i].hash == hash && suggestions[slots[i].index - 1] == suggestion)
+                {
+                    return;
+                }
+            }
+        }
+
+    private:
+        // An index of 0 marks an empty slot; otherwise, the slot refers
+        // to suggestions[index - 1].
+        struct Slot
+        {
+            unsigned int hash = 0;
+            unsigned int index = 0;
+        };
+
+        vector<string>& suggestions;
+        vector<Slot> slots;
+
+        void grow()
+        {
+            vector<Slot> old_slots(slots.size() * 2);
+            swap(slots, old_slots);
+            size_t mask = slots.size() - 1;
+
+            for (const Slot& slot : old_slots)
+            {
+                if (slot.index != 0)
+                {
+                    size_t i = slot.hash & mask;
+
+                    while (slots[i].index != 0)
+                    {
+                        i = (i + 1) & mask;
+                    }
+
+                    slots[i] = slot;
+                }
+            }
+        }
+    };
+}
+
+
 WordChecker::WordChecker(const Set<std::string>& words)
-    : words{words}
+    : words{words}, viewLookup{dynamic_cast<const StringViewLookup*>(&words)},
+      prefixLookup{dynamic_cast<const PrefixLookup*>(&words)}
 {
 }
 
@@ -24,76 +111,217 @@ bool WordChecker::wordExists(const std::string& word) const
 }
 
 
+bool WordChecker::exists(std::string_view word) const
+{
+    if (viewLookup != nullptr)
+    {
+        return viewLookup->containsView(word);
+    }
+    else
+    {
+        return this->words.contains(string{word});
+    }
+}
+
+
 std::vector<std::string> WordChecker::findSuggestions(const std::string& word) const
 {
     vector<string> suggestions;
-    string all_letter = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    SuggestionCollector collector{suggestions};
 
-    ///----------------------------------Swapping each adjacent pair of characters in the word-------------------
-    for (int i = 0; i < word.size()-1; i++)
+    // Every candidate is built in place in this one buffer and looked up
+    // through a view of it, so only the candidates that turn out to be
+    // words are ever copied into strings of their own.
+    string candidate;
+    candidate.reserve(word.size() + 1);
+
+    for (Family family : FAMILIES)
     {
-        string result_1 = word;
-        swap(result_1[i],result_1[i+1]);
-        if (wordExists(result_1)==true && find(suggestions.begin(),suggestions.end(), result_1) == suggestions.end())
+        suggest_range(word, family, 0, positions(family, word.size()), candidate,
+            [&](string_view result) { collector.add(result); });
+    }
+
+    return suggestions;
+}
+
+
+std::vector<std::string> WordChecker::findSuggestions(const std::string& word, WorkStealingPool& pool) const
+{
+    // The candidates are split into tasks of a few positions of one family
+    // each, listed in the order the serial version visits them.  Each task
+    // collects its own suggestions, and they're merged in task order once
+    // every task has finished, so the result is the same as the serial
+    // version's no matter which threads ran which tasks.
+    struct Task
+    {
+        Family family;
+        size_t first;
+        size_t last;
+        vector<string> found;
+    };
+
+    vector<Task> tasks;
+
+    for (Family family : FAMILIES)
+    {
+        size_t count = positions(family, word.size());
+        size_t step = family == Family::insertion || family == Family::replacement
+            ? POSITIONS_PER_TASK : max<size_t>(count, 1);
+
+        for (size_t first = 0; first < count; first += step)
         {
-            suggestions.push_back(result_1);
+            tasks.push_back(Task{family, first, min(first + step, count), {}});
         }
     }
-    ///-----------------------------------Each letter from 'A' through 'Z' is inserted---------------------------
-    for(int m = 0; m <= word.size(); m++)
+
+    pool.run(tasks.size(), [&](size_t i)
+    {
+        Task& task = tasks[i];
+        string candidate;
+        candidate.reserve(word.size() + 1);
+
+        suggest_range(word, task.family, task.first, task.last, candidate,
+            [&](string_view result) { task.found.emplace_back(result); });
+    });
+
+    vector<string> suggestions;
+    SuggestionCollector collector{suggestions};
+
+    for (const Task& task : tasks)
     {
-        for (int n = 0; n < all_letter.size(); n++)
+        for (const string& found : task.found)
         {
-            string result_2 = word;
-            result_2.insert(m,all_letter.substr(n,1));
-            if (wordExists(result_2)==true && find(suggestions.begin(),suggestions.end(), result_2) == suggestions.end())
-            {
-                suggestions.push_back(result_2);
-            }
+            collector.add(found);
         }
     }
-    ///-----------------------------------Deleting each character from the word----------------------------------
-    for(int p = 0; p < word.size(); p++)
+
+    return suggestions;
+}
+
+
+size_t WordChecker::positions(Family family, size_t length) noexcept
+{
+    switch (family)
+    {
+    case Family::swap:
+    case Family::split:
+        return length > 0 ? length - 1 : 0;
+
+    case Family::insertion:
+        return length + 1;
+
+    default:
+        return length;
+    }
+}
+
+
+template <typename Found>
+void WordChecker::suggest_range(
+    const std::string& word, Family family, size_t first, size_t last,
+    std::string& candidate, Found found) const
+{
+    const string_view all_letter = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+    auto suggest = [&](string_view result)
     {
-        string result_3 = word;
-        result_3 = result_3.erase(p,1);
-        if (wordExists(result_3)==true && find(suggestions.begin(),suggestions.end(), result_3) == suggestions.end())
+        if (exists(result))
         {
-            suggestions.push_back(result_3);
+            found(result);
         }
+    };
 
-    }
-    ///-----------------------------------Replacing each word with 'A' through 'Z'-------------------------------
-    for(int i = 0; i < word.size(); i++)
+    switch (family)
     {
-        for(int x = 0; x < all_letter.size();x++)
+    ///----------------------------------Swapping each adjacent pair of characters in the word-------------------
+    case Family::swap:
+        candidate = word;
+        for (size_t i = first; i < last; i++)
         {
-            string result_4 = word;
-            result_4[i] = all_letter[x];
-            if (wordExists(result_4)==true && find(suggestions.begin(),suggestions.end(), result_4) == suggestions.end())
+            swap(candidate[i],candidate[i+1]);
+            suggest(candidate);
+            swap(candidate[i],candidate[i+1]);
+        }
+        break;
+    ///-----------------------------------Each letter from 'A' through 'Z' is inserted---------------------------
+    // The buffer holds the word with one extra cell at index m, which
+    // moves one step to the right each time m does.
+    case Family::insertion:
+        candidate.assign(word, 0, first).append(1, ' ').append(word, first, string::npos);
+        for(size_t m = first; m < last; m++)
+        {
+            if (m > first)
             {
-                suggestions.push_back(result_4);
+                candidate[m-1] = word[m-1];
+            }
+            for (size_t n = 0; n < all_letter.size(); n++)
+            {
+                candidate[m] = all_letter[n];
+                suggest(candidate);
             }
-
         }
-    }
+        break;
+    ///-----------------------------------Deleting each character from the word----------------------------------
+    // Likewise, the buffer holds the word without the character at index
+    // p, with the gap moving one step to the right each time p does.
+    case Family::deletion:
+        if (first < last)
+        {
+            candidate.assign(word, 0, first).append(word, first + 1, string::npos);
+        }
+        for(size_t p = first; p < last; p++)
+        {
+            if (p > first)
+            {
+                candidate[p-1] = word[p-1];
+            }
+            suggest(candidate);
+        }
+        break;
+    ///-----------------------------------Replacing each word with 'A' through 'Z'-------------------------------
+    case Family::replacement:
+        candidate = word;
+        for(size_t i = first; i < last; i++)
+        {
+            for(size_t x = 0; x < all_letter.size();x++)
+            {
+                candidate[i] = all_letter[x];
+                suggest(candidate);
+            }
+            candidate[i] = word[i];
+        }
+        break;
     ///-----------------------------------Splitting the word into a pair adding space----------------------------
-    string temp1;
-    string temp2;
-    for(int m = 0;m<word.size()-1;m++)
+    case Family::split:
     {
-        temp1 = word.substr(0,m);
-        temp2 = word.substr(m);
-        string result_5;
-        result_5 = temp1 + " " + temp2;
-        if (wordExists(temp1)==true&&wordExists(temp2)==true && find(suggestions.begin(),suggestions.end(), result_5) == suggestions.end())
+        string_view whole = word;
+        for(size_t m = first;m < last;m++)
         {
-            suggestions.push_back(result_5);
-        }
+            string_view temp1 = whole.substr(0,m);
+            string_view temp2 = whole.substr(m);
+            if (exists(temp1)==true&&exists(temp2)==true)
+            {
+                candidate.assign(temp1).append(" ").append(temp2);
+                found(candidate);
+            }
 
+        }
+        break;
+    }
     }
+}
 
 
-    return suggestions;
+std::vector<std::string> WordChecker::findCompletions(const std::string& prefix, unsigned int limit) const
+{
+    std::vector<std::string> completions;
+
+    if (prefixLookup != nullptr)
+    {
+        prefixLookup->visitPrefix(prefix, limit,
+            [&](const std::string& word) { completions.push_back(word); });
+    }
+
+    return completions;
 }
 
@@ -16,9 +16,15 @@
 #ifndef WORDCHECKER_HPP
 #define WORDCHECKER_HPP
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "Set.hpp"
+#include "StringLookup.hpp"
+
+
+class WorkStealingPool;
 
 
 
@@ -42,8 +48,59 @@ public:
     std::vector<std::string> findSuggestions(const std::string& word) const;
 
 
+    // This version of findSuggestions() returns the same suggestions, in
+    // the same order, but splits the candidates among the threads of the
+    // given pool.  Splitting them up has a cost of its own, so this only
+    // pays off for long words (see WordChecker_Benchmarks.cpp); it's up
+    // to the caller to decide which words are long enough.  The pool runs
+    // one batch at a time, so calls sharing a pool take turns.
+    std::vector<std::string> findSuggestions(const std::string& word, WorkStealingPool& pool) const;
+
+
+    // findCompletions() returns up to "limit" of the words that begin with
+    // the given prefix, in alphabetical order.  It can only find them if
+    // the Set is an ordered one that offers a PrefixLookup (e.g., an
+    // AVLSet); for any other Set, it returns no completions.
+    std::vector<std::string> findCompletions(const std::string& prefix, unsigned int limit) const;
+
+
 private:
     const Set<std::string>& words;
+
+    // If the Set offers lookups by std::string_view, this points to that
+    // interface (and is otherwise nullptr), which lets candidate words be
+    // looked up without building a std::string for each one.
+    const StringViewLookup* viewLookup;
+
+    // Likewise, if the Set can visit the words with a given prefix, this
+    // points to that interface.
+    const PrefixLookup* prefixLookup;
+
+    // The families of candidates that findSuggestions() looks up, in the
+    // order it looks them up.  Each is indexed by a position in the word,
+    // and suggest_range() looks up the candidates for a range of those
+    // positions, which lets the parallel version split them into tasks.
+    enum class Family
+    {
+        swap, insertion, deletion, replacement, split
+    };
+
+    static constexpr Family FAMILIES[] = {
+        Family::swap, Family::insertion, Family::deletion, Family::replacement, Family::split};
+
+    // Insertions and replacements look up 26 candidates per position, so
+    // they're split into tasks of this many positions; each of the other
+    // families has only one lookup per position, and is one task.
+    static constexpr std::size_t POSITIONS_PER_TASK = 4;
+
+    bool exists(std::string_view word) const;
+
+    static std::size_t positions(Family family, std::size_t length) noexcept;
+
+    template <typename Found>
+    void suggest_range(
+        const std::string& word, Family family, std::size_t first, std::size_t last,
+        std::string& candidate, Found found) const;
 };
 
 
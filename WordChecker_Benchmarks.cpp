@@ -0,0 +1,529 @@
+// WordChecker_Benchmarks.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Benchmarks for WordChecker.
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AVLSet.hpp"
+#include "BKTree.hpp"
+#include "Benchmark.hpp"
+#include "DeletionIndex.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+#include "TrieSet.hpp"
+#include "WordChecker.hpp"
+#include "WorkStealingPool.hpp"
+
+
+namespace
+{
+    // allShortWords() returns every word of one to maxLength letters.
+    std::vector<std::string> allShortWords(unsigned int maxLength)
+    {
+        std::vector<std::string> words{""};
+        std::vector<std::string> result;
+
+        for (unsigned int length = 1; length <= maxLength; ++length)
+        {
+            std::vector<std::string> longer;
+
+            for (const std::string& word : words)
+            {
+                for (char c = 'A'; c <= 'Z'; ++c)
+                {
+                    longer.push_back(word + c);
+                }
+            }
+
+            result.insert(result.end(), longer.begin(), longer.end());
+            words = std::move(longer);
+        }
+
+        return result;
+    }
+
+
+    // misspell() returns queries made by applying one random edit to
+    // randomly-chosen dictionary words, which is what the suggestion
+    // engines see most of the time.
+    std::vector<std::string> misspell(const std::vector<std::string>& words, unsigned int count, unsigned int seed)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        std::vector<std::string> queries;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string query = words[engine() % words.size()];
+            std::size_t at = engine() % query.size();
+
+            switch (engine() % 3)
+            {
+            case 0:
+                query.insert(query.begin() + at, static_cast<char>(letter(engine)));
+                break;
+
+            case 1:
+                query.erase(at, 1);
+                break;
+
+            default:
+                query[at] = static_cast<char>(letter(engine));
+                break;
+            }
+
+            queries.push_back(std::move(query));
+        }
+
+        return queries;
+    }
+
+
+    // replaceOneLetter() is like misspell(), but only ever replaces a
+    // letter, so every query is as long as the word it came from.
+    std::vector<std::string> replaceOneLetter(const std::vector<std::string>& words, unsigned int count, unsigned int seed)
+    {
+        std::mt19937 engine{seed};
+        std::uniform_int_distribution<int> letter{'A', 'Z'};
+        std::vector<std::string> queries;
+
+        for (unsigned int i = 0; i < count; ++i)
+        {
+            std::string query = words[engine() % words.size()];
+            query[engine() % query.size()] = static_cast<char>(letter(engine));
+            queries.push_back(std::move(query));
+        }
+
+        return queries;
+    }
+
+
+    // editsWithin() returns every word in the set within the given
+    // Levenshtein distance of the query, found by enumerating every
+    // insertion, deletion and replacement (of 'A' through 'Z') up to that
+    // many times over.
+    std::vector<std::string> editsWithin(const HashSet<std::string>& set, const std::string& query, unsigned int distance)
+    {
+        std::vector<std::string> frontier{query};
+        std::vector<std::string> seen{query};
+
+        for (unsigned int round = 0; round < distance; ++round)
+        {
+            std::vector<std::string> next;
+
+            for (const std::string& word : frontier)
+            {
+                for (std::size_t i = 0; i <= word.size(); ++i)
+                {
+                    for (char c = 'A'; c <= 'Z'; ++c)
+                    {
+                        next.push_back(word.substr(0, i) + c + word.substr(i));
+
+                        if (i < word.size())
+                        {
+                            std::string replaced = word;
+                            replaced[i] = c;
+                            next.push_back(replaced);
+                        }
+                    }
+
+                    if (i < word.size())
+                    {
+                        next.push_back(word.substr(0, i) + word.substr(i + 1));
+                    }
+                }
+            }
+
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+            seen.insert(seen.end(), next.begin(), next.end());
+            frontier = std::move(next);
+        }
+
+        std::sort(seen.begin(), seen.end());
+        seen.erase(std::unique(seen.begin(), seen.end()), seen.end());
+
+        std::vector<std::string> found;
+
+        for (const std::string& candidate : seen)
+        {
+            if (set.contains(candidate))
+            {
+                found.push_back(candidate);
+            }
+        }
+
+        return found;
+    }
+
+
+    // checkDocument() looks up every token in the document in the given
+    // set: first with one contains() call per token, in the order they
+    // appear; then by sorting the distinct tokens and calling contains()
+    // on each; then by sorting them and calling containsSorted() once.
+    // Reports the cost of the first and of sorting per token in the
+    // document, and of the last two per distinct token.
+    template <typename SetType>
+    void checkDocument(const char* label, const SetType& set, const std::vector<std::string>& document)
+    {
+        bench::Stopwatch watch;
+        unsigned int misspelled = 0;
+
+        for (const std::string& token : document)
+        {
+            misspelled += set.contains(token) ? 0 : 1;
+        }
+
+        double eachNs = bench::nanosPerOperation(watch, document.size());
+        watch.restart();
+
+        std::vector<std::string> distinct = document;
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+
+        double sortMs = watch.elapsedMilliseconds();
+        watch.restart();
+
+        for (const std::string& token : distinct)
+        {
+            misspelled += set.contains(token) ? 0 : 1;
+        }
+
+        double distinctMs = watch.elapsedMilliseconds();
+        watch.restart();
+
+        std::vector<char> found(distinct.size());
+        set.containsSorted(distinct.begin(), distinct.end(), found.begin());
+
+        double sortedMs = watch.elapsedMilliseconds();
+        misspelled += static_cast<unsigned int>(std::count(found.begin(), found.end(), 0));
+        bench::doNotOptimize(misspelled);
+
+        std::printf("    %-12s contains() %7.1f ns/token  sort %6.1f ns/token  + contains() %7.1f or containsSorted() %7.1f ns/distinct token\n",
+            label, eachNs, sortMs * 1e6 / document.size(),
+            distinctMs * 1e6 / distinct.size(), sortedMs * 1e6 / distinct.size());
+    }
+
+
+    template <typename Engine>
+    double microsPerQuery(const Engine& engine, const std::vector<std::string>& queries, std::size_t& suggestions)
+    {
+        bench::Stopwatch watch;
+
+        for (const std::string& query : queries)
+        {
+            suggestions += engine.findSuggestions(query).size();
+        }
+
+        return watch.elapsedMilliseconds() * 1000.0 / queries.size();
+    }
+}
+
+
+BENCHMARK(WordChecker, denseNeighbourhoods)
+{
+    // Every word of up to three letters is in the dictionary, along with
+    // about half of all four-letter words, so a three-letter query has
+    // over a hundred suggestions, many of them found more than once.
+    std::vector<std::string> dictionary = allShortWords(3);
+    std::vector<std::string> fourLetterWords = bench::makeWords(230000, 46, 4, 4);
+    dictionary.insert(dictionary.end(), fourLetterWords.begin(), fourLetterWords.end());
+
+    HashSet<std::string> set;
+
+    for (const std::string& word : dictionary)
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+    std::vector<std::string> queries = bench::makeWords(2000, 99, 2, 3);
+
+    bench::Stopwatch watch;
+    std::size_t suggestions = 0;
+
+    for (const std::string& query : queries)
+    {
+        suggestions += checker.findSuggestions(query).size();
+    }
+
+    double usPerQuery = watch.elapsedMilliseconds() * 1000.0 / queries.size();
+    bench::doNotOptimize(suggestions);
+
+    std::printf("  %zu queries  %.1f suggestions/query  %.2f us/query\n",
+        queries.size(), static_cast<double>(suggestions) / queries.size(), usPerQuery);
+}
+
+
+BENCHMARK(WordChecker, deletionIndexVersusBruteForce)
+{
+    for (unsigned int size : {100000u, 500000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 3);
+        std::vector<std::string> queries = misspell(words, 20000, 4);
+
+        bench::Stopwatch watch;
+        HashSet<std::string> set;
+
+        for (const std::string& word : words)
+        {
+            set.add(word);
+        }
+
+        double setBuildMs = watch.elapsedMilliseconds();
+        WordChecker checker{set};
+
+        watch.restart();
+        DeletionIndex index{words};
+        double indexBuildMs = watch.elapsedMilliseconds();
+
+        std::size_t bruteSuggestions = 0;
+        std::size_t indexSuggestions = 0;
+        double bruteUs = microsPerQuery(checker, queries, bruteSuggestions);
+        double indexUs = microsPerQuery(index, queries, indexSuggestions);
+
+        std::printf("  %7u words  brute force: build %7.1f ms  %7.2f us/query (%zu suggestions)\n",
+            size, setBuildMs, bruteUs, bruteSuggestions);
+        std::printf("  %7u words  index:       build %7.1f ms  %7.2f us/query (%zu suggestions)  %.1f MB (%.1f bytes/word)\n",
+            size, indexBuildMs, indexUs, indexSuggestions,
+            index.memoryUsage() / 1048576.0, static_cast<double>(index.memoryUsage()) / size);
+    }
+}
+
+
+BENCHMARK(WordChecker, bkTreeVersusEnumeration)
+{
+    const unsigned int size = 100000;
+    std::vector<std::string> words = bench::makeWords(size, 5);
+    std::vector<std::string> queries = misspell(words, 500, 6);
+
+    HashSet<std::string> set;
+
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+
+    bench::Stopwatch watch;
+    BKTree tree{words};
+    std::printf("  %u words  BK-tree build %.1f ms\n", size, watch.elapsedMilliseconds());
+
+    TrieSet trie;
+
+    for (const std::string& word : words)
+    {
+        trie.add(word);
+    }
+
+    trie.minimize();
+
+    for (unsigned int distance : {1u, 2u})
+    {
+        std::size_t enumerated = 0;
+        std::size_t searched = 0;
+
+        watch.restart();
+
+        for (const std::string& query : queries)
+        {
+            enumerated += editsWithin(set, query, distance).size();
+        }
+
+        double enumerationUs = watch.elapsedMilliseconds() * 1000.0 / queries.size();
+        watch.restart();
+
+        for (const std::string& query : queries)
+        {
+            searched += tree.findSuggestions(query, distance).size();
+        }
+
+        double treeUs = watch.elapsedMilliseconds() * 1000.0 / queries.size();
+        std::size_t walked = 0;
+        watch.restart();
+
+        for (const std::string& query : queries)
+        {
+            walked += trie.findSuggestions(query, distance).size();
+        }
+
+        double trieUs = watch.elapsedMilliseconds() * 1000.0 / queries.size();
+
+        std::printf("  distance %u  enumeration %9.1f us/query (%zu found)  BK-tree %9.1f us/query (%zu found)"
+            "  DAWG %7.1f us/query (%zu found)\n",
+            distance, enumerationUs, enumerated, treeUs, searched, trieUs, walked);
+    }
+}
+
+
+BENCHMARK(WordChecker, completions)
+{
+    const unsigned int size = 250000;
+    const unsigned int limit = 10;
+    std::vector<std::string> words = bench::makeWords(size, 18);
+
+    AVLSet<std::string> set;
+    set.addSorted(words.begin(), words.end());
+    WordChecker checker{set};
+
+    for (std::size_t length : {1u, 2u, 3u, 4u})
+    {
+        std::vector<std::string> prefixes;
+        std::mt19937 engine{static_cast<unsigned int>(length)};
+
+        for (unsigned int i = 0; i < 5000; ++i)
+        {
+            prefixes.push_back(words[engine() % size].substr(0, length));
+        }
+
+        std::size_t found = 0;
+        bench::Stopwatch watch;
+
+        for (const std::string& prefix : prefixes)
+        {
+            found += checker.findCompletions(prefix, limit).size();
+        }
+
+        double scanUs = watch.elapsedMilliseconds() * 1000.0 / prefixes.size();
+
+        // The only way to do this before was to visit the whole set, which
+        // is slow enough that a few queries are plenty to measure it.
+        std::size_t traversed = 0;
+        watch.restart();
+
+        for (unsigned int i = 0; i < 20; ++i)
+        {
+            std::vector<std::string> completions;
+
+            set.inorder([&](const std::string& word)
+            {
+                if (completions.size() < limit && word.compare(0, length, prefixes[i]) == 0)
+                {
+                    completions.push_back(word);
+                }
+            });
+
+            traversed += completions.size();
+        }
+
+        double traversalUs = watch.elapsedMilliseconds() * 1000.0 / 20;
+        bench::doNotOptimize(found + traversed);
+
+        std::printf("  prefix length %zu  findCompletions %6.2f us/query  full inorder traversal %9.1f us/query\n",
+            length, scanUs, traversalUs);
+    }
+}
+
+
+BENCHMARK(WordChecker, sortedDocumentCheck)
+{
+    for (unsigned int size : {250000u, 1000000u})
+    {
+        std::vector<std::string> words = bench::makeWords(size, 27);
+        AVLSet<std::string> tree;
+        SkipListSet<std::string> skipList;
+
+        for (const std::string& word : words)
+        {
+            tree.add(word);
+            skipList.add(word);
+        }
+
+        for (unsigned int length : {1000u, 10000u, 100000u})
+        {
+            // Documents repeat words often, so each token is drawn from a
+            // vocabulary a tenth the document's length, and one token in
+            // twenty is misspelled.
+            std::mt19937 engine{length};
+            std::vector<std::string> vocabulary;
+
+            for (unsigned int i = 0; i < length / 10; ++i)
+            {
+                vocabulary.push_back(words[engine() % size]);
+            }
+
+            std::vector<std::string> misspellings = misspell(words, length / 20, length);
+            std::vector<std::string> document;
+
+            for (unsigned int i = 0; i < length; ++i)
+            {
+                document.push_back(i % 20 == 0
+                    ? misspellings[i / 20]
+                    : vocabulary[engine() % vocabulary.size()]);
+            }
+
+            std::printf("  %u words, %u-token document\n", size, length);
+            checkDocument("AVLSet", tree, document);
+            checkDocument("SkipListSet", skipList, document);
+        }
+    }
+}
+
+
+BENCHMARK(WordChecker, parallelSuggestionLatency)
+{
+    std::vector<std::string> words = bench::makeWords(200000, 43);
+    HashSet<std::string> set;
+
+    for (const std::string& word : words)
+    {
+        set.add(word);
+    }
+
+    WordChecker checker{set};
+    std::vector<unsigned int> threadCounts{2, 4, 8};
+    std::vector<std::unique_ptr<WorkStealingPool>> pools;
+
+    for (unsigned int threads : threadCounts)
+    {
+        pools.push_back(std::make_unique<WorkStealingPool>(threads));
+    }
+
+    std::printf("  %u hardware threads\n", std::thread::hardware_concurrency());
+
+    for (unsigned int length : {5u, 10u, 20u, 40u})
+    {
+        // Each query is a word of the given length with one letter
+        // replaced, and the word itself is in the set, so every query has
+        // at least one suggestion.
+        std::vector<std::string> originals = bench::makeWords(500, length, length, length);
+        std::vector<std::string> queries = replaceOneLetter(originals, 500, length);
+
+        for (const std::string& original : originals)
+        {
+            set.add(original);
+        }
+
+        auto microsPerQuery = [&](auto suggest)
+        {
+            std::size_t found = 0;
+            bench::Stopwatch watch;
+
+            for (const std::string& query : queries)
+            {
+                found += suggest(query).size();
+            }
+
+            bench::doNotOptimize(found);
+            return watch.elapsedMilliseconds() * 1000.0 / queries.size();
+        };
+
+        std::printf("  length %2u  serial %7.2f us", length,
+            microsPerQuery([&](const std::string& query) { return checker.findSuggestions(query); }));
+
+        for (std::size_t i = 0; i < pools.size(); ++i)
+        {
+            std::printf("  %u threads %7.2f us", threadCounts[i],
+                microsPerQuery([&](const std::string& query) { return checker.findSuggestions(query, *pools[i]); }));
+        }
+
+        std::printf("\n");
+    }
+}
@@ -0,0 +1,335 @@
+// WordChecker_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WordChecker beyond the provided sanity checks.
+//
+// This file replaces the global operator new (in all of its forms) with
+// one that counts calls, so that tests can check how many allocations a
+// piece of code makes.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AVLSet.hpp"
+#include "HashSet.hpp"
+#include "SkipListSet.hpp"
+#include "WordChecker.hpp"
+#include "WorkStealingPool.hpp"
+
+
+namespace
+{
+    std::atomic<unsigned long> allocations{0};
+
+
+    // Every form of operator new allocates through one of these, and every
+    // form of operator delete frees with std::free(), so that a pointer is
+    // always freed the same way it was allocated, no matter which forms a
+    // piece of code (or the Standard Library) happens to pair up.  (This
+    // file is linked into the same test program as all of the others, so
+    // a form left unreplaced would pair the default allocator with this
+    // one, which AddressSanitizer reports as a mismatch.)
+    [[gnu::noinline]] void* countedAllocation(std::size_t size) noexcept
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+
+    [[gnu::noinline]] void* countedAllocation(std::size_t size, std::align_val_t alignment) noexcept
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+
+        // std::aligned_alloc() requires a size that's a multiple of the
+        // alignment.
+        std::size_t align = static_cast<std::size_t>(alignment);
+        std::size_t rounded = size == 0 ? align : (size + align - 1) / align * align;
+        return std::aligned_alloc(align, rounded);
+    }
+
+
+    template <typename... Alignment>
+    void* throwingAllocation(std::size_t size, Alignment... alignment)
+    {
+        if (void* p = countedAllocation(size, alignment...))
+        {
+            return p;
+        }
+
+        throw std::bad_alloc{};
+    }
+}
+
+
+// The replacement operators are kept out of line, so that the compiler
+// never sees a pointer from malloc() reaching operator delete, or one from
+// operator new reaching free(), which it would warn about as mismatched.
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    return throwingAllocation(size);
+}
+
+
+[[gnu::noinline]] void* operator new[](std::size_t size)
+{
+    return throwingAllocation(size);
+}
+
+
+[[gnu::noinline]] void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size);
+}
+
+
+[[gnu::noinline]] void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size);
+}
+
+
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return throwingAllocation(size, alignment);
+}
+
+
+[[gnu::noinline]] void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return throwingAllocation(size, alignment);
+}
+
+
+[[gnu::noinline]] void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size, alignment);
+}
+
+
+[[gnu::noinline]] void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return countedAllocation(size, alignment);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+
+[[gnu::noinline]] void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    std::free(p);
+}
+
+
+namespace
+{
+    const std::vector<std::string> DICTIONARY{
+        "CAT", "CART", "CAST", "COAT", "CUT", "AT", "ACT", "SCAT",
+        "BAT", "HAT", "THE", "CATS", "TAC", "A", "THECAT", "APPLE"};
+
+
+    template <typename SetType>
+    void fill(SetType& set)
+    {
+        for (const std::string& word : DICTIONARY)
+        {
+            set.add(word);
+        }
+    }
+}
+
+
+TEST(WordChecker_Tests, suggestionsAreTheSameForEverySet)
+{
+    HashSet<std::string> hash;
+    AVLSet<std::string> avl;
+    SkipListSet<std::string> skipList;
+    fill(hash);
+    fill(avl);
+    fill(skipList);
+
+    WordChecker hashChecker{hash};
+    WordChecker avlChecker{avl};
+    WordChecker skipListChecker{skipList};
+
+    for (const char* word : {"CAT", "CTA", "CT", "CAAT", "THECAT", "ATHE", "X", "APPEL"})
+    {
+        std::vector<std::string> expected = hashChecker.findSuggestions(word);
+        EXPECT_EQ(expected, avlChecker.findSuggestions(word)) << word;
+        EXPECT_EQ(expected, skipListChecker.findSuggestions(word)) << word;
+    }
+}
+
+
+TEST(WordChecker_Tests, suggestionsComeFromEachAlgorithmInOrder)
+{
+    HashSet<std::string> set;
+    fill(set);
+    WordChecker checker{set};
+
+    // Swapping gives ACT, inserting gives SCAT, COAT, CART, CAST and CATS,
+    // deleting gives AT, replacing gives BAT, CAT (by replacing a letter
+    // with itself), HAT and CUT, and splitting gives nothing.
+    std::vector<std::string> expected{
+        "ACT", "SCAT", "COAT", "CART", "CAST", "CATS", "AT",
+        "BAT", "CAT", "HAT", "CUT"};
+
+    EXPECT_EQ(expected, checker.findSuggestions("CAT"));
+
+    // Replacing a letter of THECAT with itself finds THECAT, and splitting
+    // it finds THE and CAT.
+    std::vector<std::string> split{"THECAT", "THE CAT"};
+    EXPECT_EQ(split, checker.findSuggestions("THECAT"));
+}
+
+
+TEST(WordChecker_Tests, emptyWordOnlyHasInsertions)
+{
+    HashSet<std::string> set;
+    fill(set);
+    WordChecker checker{set};
+
+    EXPECT_EQ(std::vector<std::string>{"A"}, checker.findSuggestions(""));
+}
+
+
+TEST(WordChecker_Tests, parallelSuggestionsMatchSerialOnes)
+{
+    HashSet<std::string> set;
+    fill(set);
+    set.add("CATASTROPHE");
+    set.add("CATASTROPHES");
+    set.add("CATASTROPHIC");
+    set.add("ASTROPHE");
+    WordChecker checker{set};
+
+    WorkStealingPool single{1};
+    WorkStealingPool pool{4};
+
+    for (std::string word : {"", "A", "CAT", "THECAT", "CTA", "CATASTROPHE",
+        "CATASTROPHEE", "CTASTROPHE", "CATASTROPHEZZZZZZZZZZZZZZZZZZZZZZZZZZZ"})
+    {
+        std::vector<std::string> expected = checker.findSuggestions(word);
+        EXPECT_EQ(expected, checker.findSuggestions(word, single)) << word;
+        EXPECT_EQ(expected, checker.findSuggestions(word, pool)) << word;
+    }
+}
+
+
+TEST(WordChecker_Tests, candidatesAreNotAllocated)
+{
+    HashSet<std::string> hash;
+    AVLSet<std::string> avl;
+    fill(hash);
+    fill(avl);
+
+    // This word is too long for the small-string optimization, so each
+    // candidate would need an allocation if it were built as a string.
+    // The only allocation should be the reusable candidate buffer.
+    const std::string word = "QQQQQQQQQQQQQQQQQQQQQQQQQQQQQQ";
+
+    for (const Set<std::string>* set : {static_cast<const Set<std::string>*>(&hash),
+                                        static_cast<const Set<std::string>*>(&avl)})
+    {
+        WordChecker checker{*set};
+
+        unsigned long before = allocations.load();
+        std::vector<std::string> suggestions = checker.findSuggestions(word);
+        unsigned long after = allocations.load();
+
+        EXPECT_TRUE(suggestions.empty());
+        EXPECT_EQ(1, after - before);
+    }
+}
+
+
+
+TEST(WordChecker_Tests, completionsComeFromOrderedSets)
+{
+    AVLSet<std::string> avl;
+    fill(avl);
+    WordChecker checker{avl};
+
+    EXPECT_EQ((std::vector<std::string>{"CART", "CAST", "CAT", "CATS"}), checker.findCompletions("CA", 10));
+    EXPECT_EQ((std::vector<std::string>{"CART", "CAST"}), checker.findCompletions("CA", 2));
+    EXPECT_EQ((std::vector<std::string>{"THE", "THECAT"}), checker.findCompletions("THE", 10));
+    EXPECT_TRUE(checker.findCompletions("Q", 10).empty());
+}
+
+
+TEST(WordChecker_Tests, unorderedSetsHaveNoCompletions)
+{
+    HashSet<std::string> hash;
+    fill(hash);
+    WordChecker checker{hash};
+
+    EXPECT_TRUE(checker.findCompletions("CA", 10).empty());
+}
@@ -0,0 +1,224 @@
+// WorkStealingPool.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+
+#include <algorithm>
+#include <utility>
+#include "WorkStealingPool.hpp"
+
+
+WorkStealingPool::WorkStealingPool(unsigned int threadCount)
+    : queueCount{std::max(threadCount, 1u)}, queues{new Queue[queueCount]},
+      task{nullptr}, abandoned{false}, generation{0}, working{0}, stopping{false}
+{
+    workers.reserve(queueCount - 1);
+
+    try
+    {
+        for (unsigned int i = 1; i < queueCount; ++i)
+        {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+}
+
+
+WorkStealingPool::~WorkStealingPool() noexcept
+{
+    stop();
+}
+
+
+void WorkStealingPool::run(std::size_t taskCount, const std::function<void(std::size_t)>& task)
+{
+    std::lock_guard<std::mutex> batchLock{batchMutex};
+
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    // Only the calling thread is running, so the queues can be filled
+    // without locking them; locking "mutex" below publishes them.
+    for (unsigned int i = 0; i < queueCount; ++i)
+    {
+        queues[i].next = taskCount * i / queueCount;
+        queues[i].end = taskCount * (i + 1) / queueCount;
+    }
+
+    std::exception_ptr thrown;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        this->task = &task;
+        abandoned.store(false, std::memory_order_relaxed);
+        working = static_cast<unsigned int>(workers.size());
+        failure = nullptr;
+        ++generation;
+    }
+
+    batchStarted.notify_all();
+    drain(0);
+
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        batchFinished.wait(lock, [this] { return working == 0; });
+        this->task = nullptr;
+        thrown = std::exchange(failure, nullptr);
+    }
+
+    if (thrown)
+    {
+        std::rethrow_exception(thrown);
+    }
+}
+
+
+unsigned int WorkStealingPool::threadCount() const noexcept
+{
+    return queueCount;
+}
+
+
+bool WorkStealingPool::take(unsigned int self, std::size_t& index)
+{
+    Queue& queue = queues[self];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+
+    if (queue.next == queue.end)
+    {
+        return false;
+    }
+
+    index = queue.next++;
+    return true;
+}
+
+
+bool WorkStealingPool::steal(unsigned int self)
+{
+    // Victims are tried starting with the next thread over, so thieves
+    // spread out across the queues instead of all trying the same one.
+    for (unsigned int offset = 1; offset < queueCount; ++offset)
+    {
+        Queue& victim = queues[(self + offset) % queueCount];
+        std::size_t first;
+        std::size_t last;
+
+        {
+            std::lock_guard<std::mutex> lock{victim.mutex};
+            std::size_t remaining = victim.end - victim.next;
+
+            if (remaining == 0)
+            {
+                continue;
+            }
+
+            last = victim.end;
+            first = last - (remaining + 1) / 2;
+            victim.end = first;
+        }
+
+        Queue& queue = queues[self];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+        queue.next = first;
+        queue.end = last;
+        return true;
+    }
+
+    return false;
+}
+
+
+void WorkStealingPool::drain(unsigned int self)
+{
+    const std::function<void(std::size_t)>& run = *task;
+    std::size_t index;
+
+    // Once every queue is empty, the only tasks left are the ones other
+    // threads are running, since tasks never add more tasks.
+    while (!abandoned.load(std::memory_order_relaxed))
+    {
+        if (!take(self, index))
+        {
+            if (steal(self))
+            {
+                continue;
+            }
+
+            break;
+        }
+
+        try
+        {
+            run(index);
+        }
+        catch (...)
+        {
+            abandoned.store(true, std::memory_order_relaxed);
+
+            std::lock_guard<std::mutex> lock{mutex};
+
+            if (!failure)
+            {
+                failure = std::current_exception();
+            }
+        }
+    }
+}
+
+
+void WorkStealingPool::work(unsigned int self)
+{
+    unsigned long seen = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            batchStarted.wait(lock, [&] { return stopping || generation != seen; });
+
+            if (stopping)
+            {
+                return;
+            }
+
+            seen = generation;
+        }
+
+        drain(self);
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+
+            if (--working == 0)
+            {
+                batchFinished.notify_one();
+            }
+        }
+    }
+}
+
+
+void WorkStealingPool::stop() noexcept
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+
+    batchStarted.notify_all();
+
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    workers.clear();
+}
@@ -0,0 +1,103 @@
+// WorkStealingPool.hpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A WorkStealingPool runs a batch of numbered tasks on a fixed set of
+// threads, returning once every task has run.  It's meant for batches of
+// small tasks whose costs vary, such as the candidate families that
+// WordChecker::findSuggestions() looks up.
+//
+// Each thread has its own queue, which holds a contiguous range of task
+// numbers; a batch starts with the tasks split evenly among the queues.
+// A thread runs the tasks at the front of its own queue, and when that's
+// empty, it steals the back half of another thread's queue, so a thread
+// that drew cheap tasks helps the ones that drew expensive tasks rather
+// than sitting idle.  Since each queue is a range rather than a list of
+// tasks, starting a batch, taking a task, and stealing are all constant
+// time, and the only thing that's ever allocated is the pool itself.
+//
+// The thread that calls run() works on the batch too, so a pool with a
+// thread count of 1 starts no threads and runs every task in order.  One
+// batch runs at a time; a task must not call run() on its own pool.
+
+#ifndef WORKSTEALINGPOOL_HPP
+#define WORKSTEALINGPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+class WorkStealingPool
+{
+public:
+    // Initializes a pool with the given number of threads, including the
+    // one that calls run().  A thread count of 0 is treated as 1.
+    explicit WorkStealingPool(unsigned int threadCount = std::thread::hardware_concurrency());
+
+    // Stops the threads, waiting for each to finish.
+    ~WorkStealingPool() noexcept;
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+
+    // run() calls task(i) for every i from 0 through taskCount - 1, each
+    // exactly once, on whichever threads get to it, and returns when all
+    // of them have returned.  If a task throws, the tasks that haven't
+    // started yet are skipped, and the exception is rethrown from run().
+    void run(std::size_t taskCount, const std::function<void(std::size_t)>& task);
+
+
+    // threadCount() returns the number of threads that run tasks,
+    // including the one that calls run().
+    unsigned int threadCount() const noexcept;
+
+
+private:
+    // Each queue is on its own cache line, so that a thread taking tasks
+    // from its own queue doesn't slow down the others taking from theirs.
+    struct alignas(64) Queue
+    {
+        std::mutex mutex;
+        std::size_t next = 0;
+        std::size_t end = 0;
+    };
+
+    unsigned int queueCount;
+    std::unique_ptr<Queue[]> queues;
+    std::vector<std::thread> workers;
+
+    // One batch runs at a time.  Bumping "generation" wakes the workers,
+    // and the last one to count itself out of "working" wakes the thread
+    // that called run().  If a task throws, the exception is kept in
+    // "failure" and "abandoned" is set, so the remaining tasks are skipped.
+    std::mutex batchMutex;
+    std::mutex mutex;
+    std::condition_variable batchStarted;
+    std::condition_variable batchFinished;
+    const std::function<void(std::size_t)>* task;
+    std::atomic<bool> abandoned;
+    unsigned long generation;
+    unsigned int working;
+    bool stopping;
+    std::exception_ptr failure;
+
+    bool take(unsigned int self, std::size_t& index);
+    bool steal(unsigned int self);
+    void drain(unsigned int self);
+    void work(unsigned int self);
+    void stop() noexcept;
+};
+
+
+
+#endif // WORKSTEALINGPOOL_HPP
@@ -0,0 +1,138 @@
+// WorkStealingPool_Tests.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// Unit tests for WorkStealingPool.
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "WorkStealingPool.hpp"
+
+
+TEST(WorkStealingPool_Tests, runsEveryTaskExactlyOnce)
+{
+    for (unsigned int threads : {1u, 2u, 3u, 8u})
+    {
+        WorkStealingPool pool{threads};
+        EXPECT_EQ(threads, pool.threadCount());
+
+        // Task counts smaller than, equal to, and not a multiple of the
+        // number of threads, run one batch after another on the same pool.
+        for (std::size_t count : {1u, 2u, 3u, 8u, 1000u, 4099u})
+        {
+            std::vector<std::atomic<int>> runs(count);
+
+            pool.run(count, [&](std::size_t i) { runs[i]++; });
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                EXPECT_EQ(1, runs[i].load()) << threads << " threads, task " << i << " of " << count;
+            }
+        }
+    }
+}
+
+
+TEST(WorkStealingPool_Tests, oneThreadRunsTasksInOrder)
+{
+    WorkStealingPool pool{1};
+    std::vector<std::size_t> order;
+
+    pool.run(100, [&](std::size_t i) { order.push_back(i); });
+
+    ASSERT_EQ(100, order.size());
+
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+
+TEST(WorkStealingPool_Tests, idleThreadsStealFromBusyOnes)
+{
+    WorkStealingPool pool{4};
+    std::vector<std::thread::id> ranOn(64);
+
+    // The first quarter of the tasks, which start out in the calling
+    // thread's queue, are slow, so the other threads run out of their own
+    // tasks first and should take some of them.
+    pool.run(ranOn.size(), [&](std::size_t i)
+    {
+        if (i < 16)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{2});
+        }
+
+        ranOn[i] = std::this_thread::get_id();
+    });
+
+    unsigned int stolen = 0;
+
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        stolen += ranOn[i] != std::this_thread::get_id() ? 1 : 0;
+    }
+
+    EXPECT_GT(stolen, 0);
+}
+
+
+TEST(WorkStealingPool_Tests, exceptionsReachTheCaller)
+{
+    WorkStealingPool pool{3};
+    std::atomic<int> ran{0};
+
+    EXPECT_THROW(pool.run(1000, [&](std::size_t i)
+    {
+        ran++;
+
+        if (i == 500)
+        {
+            throw std::runtime_error{"task 500"};
+        }
+    }), std::runtime_error);
+
+    ran = 0;
+    pool.run(1000, [&](std::size_t) { ran++; });
+    EXPECT_EQ(1000, ran.load());
+}
+
+
+TEST(WorkStealingPool_Tests, tasksAfterAnExceptionAreSkipped)
+{
+    // With one thread, the tasks run in order on the calling thread, so
+    // exactly the tasks up to and including the one that throws have run.
+    WorkStealingPool pool{1};
+    int ran = 0;
+
+    EXPECT_THROW(pool.run(1000, [&](std::size_t i)
+    {
+        ran++;
+
+        if (i == 500)
+        {
+            throw std::runtime_error{"task 500"};
+        }
+    }), std::runtime_error);
+
+    EXPECT_EQ(501, ran);
+}
+
+
+TEST(WorkStealingPool_Tests, noTasksReturnsImmediately)
+{
+    WorkStealingPool pool{0};
+    bool ran = false;
+
+    pool.run(0, [&](std::size_t) { ran = true; });
+
+    EXPECT_EQ(1, pool.threadCount());
+    EXPECT_FALSE(ran);
+}
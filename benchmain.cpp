@@ -0,0 +1,115 @@
+// benchmain.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// This is the entry point for the benchmarks, in the same way that
+// gtestmain.cpp is the entry point for the unit tests.  Benchmarks are
+// registered in the *_Benchmarks.cpp files using the BENCHMARK() macro
+// from Benchmark.hpp.  When run with no arguments, every benchmark is
+// run; otherwise, only the benchmarks whose names contain at least one
+// of the arguments are run, e.g.,
+//
+//     bench HashSet WordChecker.findSuggestions
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include "Benchmark.hpp"
+
+
+// Every allocation made through the global operator new is counted, so
+// that benchmarks can report how many allocations the work they measure
+// performs, along with the number of bytes still allocated.
+
+namespace
+{
+    std::atomic<std::size_t> allocations{0};
+    std::atomic<std::size_t> bytes{0};
+}
+
+
+std::size_t bench::allocationCount() noexcept
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+
+std::size_t bench::liveBytes() noexcept
+{
+    return bytes.load(std::memory_order_relaxed);
+}
+
+
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+    {
+        bytes.fetch_add(malloc_usable_size(p), std::memory_order_relaxed);
+        return p;
+    }
+
+    throw std::bad_alloc{};
+}
+
+
+void operator delete(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        bytes.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    }
+
+    std::free(p);
+}
+
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    operator delete(p);
+}
+
+
+namespace
+{
+    bool isSelected(const std::string& name, int argc, char** argv)
+    {
+        if (argc < 2)
+        {
+            return true;
+        }
+
+        for (int i = 1; i < argc; ++i)
+        {
+            if (name.find(argv[i]) != std::string::npos)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    for (const bench::Benchmark& benchmark : bench::benchmarks())
+    {
+        if (isSelected(benchmark.name, argc, argv))
+        {
+            std::printf("[ RUN      ] %s\n", benchmark.name.c_str());
+            std::fflush(stdout);
+            benchmark.run();
+            std::printf("[     DONE ] %s\n\n", benchmark.name.c_str());
+        }
+    }
+
+    return 0;
+}
+
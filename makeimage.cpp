@@ -0,0 +1,69 @@
+// makeimage.cpp
+//
+// ICS 46 Spring 2018
+// Project #4: Set the Controls for the Heart of the Sun
+//
+// A small tool that writes a dictionary image for MappedDictionary from a
+// word list with one word per line, e.g.,
+//
+//     makeimage words.txt words.img
+//
+// Leading and trailing whitespace (including the '\r' of a file with
+// Windows line endings) is removed from each line, and blank lines are
+// skipped; words are otherwise used exactly as they appear.
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "MappedDictionary.hpp"
+
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " wordlist image" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in{argv[1]};
+
+    if (!in)
+    {
+        std::cerr << "ERROR: couldn't open " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> words;
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+        const char* whitespace = " \t\r\n";
+        std::string::size_type first = line.find_first_not_of(whitespace);
+
+        if (first != std::string::npos)
+        {
+            std::string::size_type last = line.find_last_not_of(whitespace);
+            words.push_back(line.substr(first, last - first + 1));
+        }
+    }
+
+    try
+    {
+        MappedDictionary::writeImage(argv[2], words);
+        MappedDictionary image{argv[2]};
+
+        std::cout << "wrote " << image.size() << " words (" << image.imageBytes()
+            << " bytes) to " << argv[2] << std::endl;
+    }
+    catch (std::exception& e)
+    {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}